@@ -26,7 +26,13 @@ int main(int argc, char* argv[]) {
             ("trust-anchor,a", po::value<std::string>()->default_value("./mnemosyne-anchor.cert"), "The trust anchor file path for the logger")
             ("database-type,t", po::value<std::string>()->default_value("leveldb"), "The database type for the logger")
             ("database-path,d", po::value<std::string>()->default_value("/tmp/mnemosyne-db/..."), "The database path for the logger")
-            ("immutability-threshold,k", po::value<uint32_t>()->default_value(UINT32_MAX), "The immutability Threshold");
+            ("immutability-threshold,k", po::value<uint32_t>()->default_value(UINT32_MAX), "The immutability Threshold")
+            ("tip-selection-policy", po::value<std::string>()->default_value("random"), "The preceding record selection policy, random or replication")
+            ("sync-group-count", po::value<uint32_t>()->default_value(1), "The number of DAG sync groups the loggers are partitioned into")
+            ("insertion-assignment", po::value<std::string>()->default_value("backoff"), "How the logger inserting an event is chosen, backoff or rendezvous")
+            ("query-prefix", po::value<std::string>(), "The prefix under which clients query the ledger, not served if absent")
+            ("producer-rate", po::value<double>()->default_value(0), "The events per second taken from each client producer, unlimited if 0")
+            ("producer-burst", po::value<double>()->default_value(64), "The events a client producer may publish at once above its rate");
 
     po::variables_map vm;
     po::store(po::command_line_parser(argc, argv).options(description).run(), vm);
@@ -73,6 +79,14 @@ int main(int argc, char* argv[]) {
         if (vm["immutability-threshold"].as<uint32_t>() != UINT32_MAX) {
             config->maxCountedReplication = vm["immutability-threshold"].as<uint32_t>();
         }
+        config->tipSelectionPolicy = vm["tip-selection-policy"].as<std::string>();
+        config->syncGroupCount = vm["sync-group-count"].as<uint32_t>();
+        config->insertionAssignment = vm["insertion-assignment"].as<std::string>();
+        if (vm.count("query-prefix")) {
+            config->queryPrefix = Name(vm["query-prefix"].as<std::string>());
+        }
+        config->defaultProducerShare.rate = vm["producer-rate"].as<double>();
+        config->defaultProducerShare.burst = vm["producer-burst"].as<double>();
         config->setDatabase(vm["database-type"].as<std::string>(), databasePath);
         mkdir("/tmp/mnemosyne-db/", S_IRWXU | S_IRWXG | S_IROTH | S_IXOTH);
     }
@@ -27,6 +27,10 @@ class Backend {
     // @param the recordName must be a full name (i.e., containing explicit digest component)
     shared_ptr<const Data> getRecord(const Name &recordName) const;
 
+    /**
+     * Store a record and index it under the full name of the event it carries, and under its time: the signature time
+     * of the record if it carries one, the time it is first stored otherwise.
+     */
     bool
     putRecord(const shared_ptr<const Data> &recordData);
 
@@ -45,12 +49,94 @@ class Backend {
 
     std::optional<std::string> getMetaData(const std::string &key) const;
 
+    void deleteMetaData(const std::string &key);
+
+    /**
+     * Index that @p referencingRecord has @p recordName as one of its preceding records.
+     * @param both must be full names
+     */
+    void addReferencingRecord(const Name &recordName, const Name &referencingRecord);
+
+    /**
+     * @return the full names of the records that have @p recordName as a preceding record, in key order
+     */
+    std::list<Name> getReferencingRecords(const Name &recordName) const;
+
+    /**
+     * @return the full names of the records carrying the event @p eventName, which must be a full name.
+     * More than one logger may have inserted the same event.
+     */
+    std::list<Name> findRecordByEvent(const Name &eventName) const;
+
+    /**
+     * @return the full names of up to @p count indexed events under @p prefix, ordered after @p startAfter if given.
+     * The order is that of the index keys, so the last name returned resumes the listing.
+     */
+    std::list<Name>
+    listEvents(const Name &prefix, const std::optional<Name> &startAfter = std::nullopt, uint32_t count = 0) const;
+
+    /**
+     * @return the full names of up to @p limit records whose time is in [@p from, @p to), in time order and after
+     * the record @p startAfter if given, so that the last name returned resumes the listing
+     * @param limit = 0 if listing all.
+     */
+    std::list<Name>
+    listRecordsByTime(const time::system_clock::time_point &from, const time::system_clock::time_point &to,
+                      uint32_t limit = 0, const std::optional<Name> &startAfter = std::nullopt) const;
+
+    /**
+     * @return the metadata keys starting with @p prefix, ordered after @p startAfter
+     */
+    std::list<std::string>
+    listMetaData(const std::string &prefix, const std::string &startAfter = "", uint32_t count = 0) const;
+
+    /**
+     * @return an immutable view of the records and metadata as of now, including the indexes, which reader threads
+     * may query concurrently while this backend keeps being written. Call it from the thread writing the backend.
+     */
+    std::shared_ptr<const Backend> snapshot() const;
+
     void triggerBackup();
 
     inline void addBackupCallback(std::function<bool()> callback) {
         m_backUpCallbacks.push_back(std::move(callback));
     }
 
+  private:
+    explicit Backend(std::shared_ptr<storage::Storage> storage);
+
+    // one key per reference, so that the referencing records of a record are listed by the key prefix of an empty
+    // @p referencingRecord
+    static std::string getReverseReferenceKey(const Name &recordName, const Name &referencingRecord);
+
+    static std::string getEventIndexKey(const Name &eventName);
+
+    static std::string getRecordTimeKey(const Name &recordName);
+
+    // time index keys sort by time, as they start with the milliseconds since the epoch in fixed width hex
+    static std::string getTimeIndexKey(uint64_t timestamp, const Name &recordName);
+
+    void addTimeIndex(const Data &recordData);
+
+    void removeTimeIndex(const Name &recordName);
+
+    /**
+     * Remove the references to and from the record @p recordData from the reverse index.
+     */
+    void removeReverseReferences(const Data &recordData);
+
+    /**
+     * @return the full name of the event carried by @p recordData, if it is a record
+     */
+    static std::optional<Name> getEventName(const Data &recordData);
+
+    /**
+     * Append @p name to the list of names under @p key, if not there yet.
+     */
+    void addIndexedName(const std::string &key, const Name &name);
+
+    void removeIndexedName(const std::string &key, const Name &name);
+
   private:
     std::shared_ptr<storage::Storage> m_storage;
     uint32_t m_seqNoBackupFreq;
@@ -3,6 +3,7 @@
 
 #include "logger-config.hpp"
 #include <iostream>
+#include <map>
 #include <utility>
 
 using namespace ndn;
@@ -10,6 +11,18 @@ namespace mnemosyne {
 
 class Config : public LoggerConfig {
   public:
+    /**
+     * What a client producer may take of this logger, see interface::ProducerLimiter.
+     */
+    struct ProducerShare {
+        // events per second refilling the producer's token bucket; 0 for no limit
+        double rate = 0;
+        // events the producer may publish at once above the rate
+        double burst = 64;
+        // turns the producer takes in each round of the admission queue
+        uint32_t weight = 1;
+    };
+
     Config(ndn::Name multicastPrefix, ndn::Name hintPrefix, ndn::Name peerPrefix,
            std::set<Name> PSPrefixes, std::set<Name> syncInterfacePrefixes = {})
             : LoggerConfig(std::move(multicastPrefix), std::move(hintPrefix), std::move(peerPrefix)),
@@ -25,10 +38,47 @@ class Config : public LoggerConfig {
     uint32_t insertBackoffMinMs = 50;
     uint32_t selfInsertResetFreq = 500;
     std::chrono::seconds seenEventTtl = std::chrono::seconds(12);
+    /**
+     * Memory for remembering seen events; beyond it the oldest are forgotten before their TTL.
+     */
+    size_t seenEventMemoryLimit = 16 * 1024 * 1024;
+    /**
+     * How often the events seen since the last backup are saved to the backend, so that a restarted logger does not
+     * insert them again. 0 disables the backup.
+     */
+    std::chrono::seconds seenEventBackupPeriod = std::chrono::seconds(5);
     std::chrono::seconds startUpDelay = std::chrono::seconds(5);
 
+    /**
+     * How the logger inserting an event is chosen: "backoff", where every logger waits a random backoff and the
+     * first one inserts, or "rendezvous", where the live logger ranking first by rendezvous hashing of the event name
+     * inserts immediately and the next ones insert after backupInsertDelay per rank if it has not appeared yet.
+     * A logger is live if it published or announced a record, or appeared in the DAG sync version vector, within
+     * liveLoggerTimeout. A logger that left stays in the version vector, so the events it ranks first are inserted
+     * by the next one after backupInsertDelay.
+     */
+    std::string insertionAssignment = "backoff";
+    std::chrono::milliseconds backupInsertDelay = std::chrono::milliseconds(500);
+    std::chrono::seconds liveLoggerTimeout = std::chrono::seconds(30);
+
+    /**
+     * The prefix under which clients query the records stored by this logger, see interface::QueryService.
+     * Empty to not serve queries.
+     */
+    Name queryPrefix;
+
     uint32_t interfaceSyncRetries = 3;
-    uint32_t insertionRetries = 3;
+    /**
+     * Events due for insertion wait in an admission queue of this depth, shared fairly among client producers, until
+     * the DAG takes them. While it is full, the interfaces are paused, and resume once it is half empty.
+     */
+    size_t admissionQueueDepth = 4096;
+    /**
+     * The share of a client producer is given by the longest prefix of its name in producerShares, or is
+     * defaultProducerShare if none matches. Events beyond the rate are dropped and counted as throttled.
+     */
+    ProducerShare defaultProducerShare;
+    std::map<Name, ProducerShare> producerShares;
     /**
      * The interface pub/sub prefix, under which an publication can reach all Mnemosyne loggers.
      */
@@ -2,11 +2,15 @@
 #define MNEMOSYNE_INCLUDE_LOGGER_CONFIG_H_
 
 #include <ndn-cxx/face.hpp>
+#include <functional>
 #include <iostream>
+#include <memory>
 #include <utility>
 
 namespace mnemosyne {
 
+class TipSelectionPolicy;
+
 class LoggerConfig {
   public:
     /**
@@ -58,6 +62,88 @@ class LoggerConfig {
     uint32_t maxCountedReplication = 2;
     uint32_t maxSelfReRefCount = 3;
 
+    /**
+     * Adapt precedingRecordNum and maxSelfReRefCount to the load, within the bounds below.
+     * Received records are accepted with any number of preceding records within the bounds,
+     * so all peers must use the same bounds.
+     */
+    bool adaptiveWidth = false;
+    size_t minPrecedingRecordNum = 2;
+    size_t maxPrecedingRecordNum = 4;
+    uint32_t minSelfReRefCount = 1;
+    uint32_t maxAdaptiveSelfReRefCount = 6;
+    /**
+     * Records accepted per second below which the width grows, and above which it shrinks.
+     */
+    double lowArrivalRate = 1;
+    double highArrivalRate = 50;
+    /**
+     * The width also grows while more of this logger's records than this are not immutable yet.
+     */
+    uint64_t widthReplicationLagThreshold = 8;
+    std::chrono::seconds widthAdjustPeriod = std::chrono::seconds(5);
+
+    /**
+     * Records waiting for their preceding records are kept in memory up to this many encoded bytes,
+     * beyond which they are moved to the backend until they can be checked.
+     */
+    size_t waitingRecordMemoryLimit = 64 * 1024 * 1024;
+    /**
+     * A waiting record is dropped if its preceding records do not arrive within this time.
+     */
+    std::chrono::seconds waitingRecordTimeout = std::chrono::seconds(600);
+    /**
+     * Number of recently accepted records remembered in memory for reference checks, 0 mean off
+     */
+    size_t recentRecordCacheSize = 65536;
+
+    /**
+     * Create a checkpoint record after this many records other than checkpoints are added to the ledger, 0 mean off.
+     * Checkpoints require maxCountedReplication above 0, as they are agreed once immutable.
+     */
+    uint32_t checkpointRecordInterval = 0;
+    /**
+     * Create a checkpoint record at this period, 0 mean off
+     */
+    std::chrono::seconds checkpointPeriod = std::chrono::seconds(0);
+    /**
+     * Start an empty logger from the latest checkpoint replicated at maxCountedReplication loggers,
+     * fetched under the hint prefix, instead of fetching every record since genesis.
+     */
+    bool bootstrapFromCheckpoint = false;
+
+    /**
+     * Reconcile the stored records with a peer reached through the hint prefix at this period, 0 mean off
+     */
+    std::chrono::seconds antiEntropyPeriod = std::chrono::seconds(0);
+
+    /**
+     * The policy for selecting preceding records: "random" or "replication".
+     * "replication" prefers tailing records referenced by the fewest other producers.
+     */
+    std::string tipSelectionPolicy = "random";
+    /**
+     * Create a custom tip selection policy instead, if set.
+     */
+    std::function<std::unique_ptr<TipSelectionPolicy>(const LoggerConfig &)> tipSelectionPolicyFactory;
+
+    /**
+     * Records submitted from other threads wait in a queue of this many records, rounded up to a power of two,
+     * until the thread of the face creates them. Submissions to a full queue are refused.
+     */
+    size_t submissionQueueCapacity = 1024;
+    /**
+     * A record waiting for enough tailing records is completed with an error after this time, 0 mean never
+     */
+    std::chrono::seconds pendingRecordTimeout = std::chrono::seconds(60);
+
+    /**
+     * Partition the loggers into this many sync groups by their peer prefix, each synchronizing under
+     * <syncPrefix>/<group>, so that sync Interests only carry the versions of one group.
+     * A logger publishes in its own group and listens to the others. All loggers must use the same count.
+     */
+    uint32_t syncGroupCount = 1;
+
     /**
      * The multicast prefix, under which an Interest can reach to all the peers in the same multicast group.
      */
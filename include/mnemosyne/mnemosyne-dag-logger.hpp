@@ -5,14 +5,19 @@
 #include "logger-config.hpp"
 #include "return-code.hpp"
 #include "backend.hpp"
+#include "tip-selection-policy.hpp"
 #include <ndn-svs/svsync-shared.hpp>
 #include <ndn-cxx/security/key-chain.hpp>
 #include <ndn-cxx/security/validator.hpp>
 #include <ndn-cxx/face.hpp>
 #include <ndn-cxx/util/scheduler.hpp>
 #include <ndn-cxx/util/io.hpp>
+#include <atomic>
+#include <future>
+#include <queue>
 #include <stack>
 #include <random>
+#include <set>
 #include <utility>
 
 
@@ -25,15 +30,36 @@ namespace dag {
 class RecordSync;
 
 class ReplicationCounter;
+
+class ImmutabilityFrontier;
+
+class ImmutableWaiters;
+
+class SyncGroups;
+
+class PendingRecords;
+
+class WidthController;
+
+class AntiEntropy;
+
+template<typename T>
+class SubmissionQueue;
 }
 
 class MnemosyneDagLogger {
   public:
+    using ImmutableCallback = std::function<void(uint64_t immutableSeqNo)>;
+    using SubmitCallback = std::function<void(ReturnCode result)>;
+    using BatchCallback = std::function<void(size_t index, ReturnCode result)>;
+
     /**
    * Initialize a MnemosyneDagLogger instance from the config.
    * @p config, input, the configuration of multicast prefix, peer prefix, and settings of Dledger behavior
    * @p keychain, input, the local NDN keychain instance
    * @p face, input, the localhost NDN face to send/receive NDN packets.
+   * @p onRecordCallback, called with each record of another logger added to the ledger, and on start with each
+   * record restored past the backed up version vector, this logger's own included.
    */
     MnemosyneDagLogger(const LoggerConfig &config, security::KeyChain &keychain,
                        Face &network, std::shared_ptr<ndn::security::Validator> m_recordValidator,
@@ -48,6 +74,34 @@ class MnemosyneDagLogger {
     virtual ReturnCode
     createRecord(Record &record);
 
+    /**
+     * Create @p records, which are moved from, in order, as soon as the DAG has enough tailing records for them.
+     * The records ready together share a width decision and are announced with a single sync update.
+     * @p callback is called with the index of each record once it is persisted and announced, and its full name,
+     * or with ReturnCode::timingError if it waited longer than pendingRecordTimeout.
+     */
+    void
+    createRecordsAsync(ndn::span<Record> records, BatchCallback callback);
+
+    /**
+     * @return the number of records waiting for enough tailing records to be created
+     */
+    size_t getPendingRecordCount() const;
+
+    /**
+     * Create @p record from any thread. Submitted records are taken in batches by the thread of the face and
+     * created as with createRecordsAsync, then @p callback is called there with the record's full name.
+     * @return ReturnCode::queueFull(), and @p callback is not called, if submissionQueueCapacity records are waiting
+     */
+    ReturnCode
+    submitRecord(Record record, SubmitCallback callback);
+
+    /**
+     * @return a future holding the result of creating the submitted @p record, ready at once if the queue is full
+     */
+    std::future<ReturnCode>
+    submitRecord(Record record);
+
     /**
      * return the current list for determining the replication count.
      * @return a list of highest sequence number for each weight, starting at maxCount and ending with 0
@@ -55,12 +109,58 @@ class MnemosyneDagLogger {
     std::list<uint64_t> getReplicationSeqId() const;
     uint64_t getMaxReferenceSeqNo() const;
 
+    /**
+     * Call @p callback once, when this logger's record @p seqId is replicated at maxCountedReplication locations.
+     * The callback is called immediately if it already is. Call on the thread of the face.
+     * @p callback receives the highest immutable sequence number at the time.
+     * @return false, and @p callback is never called, if maxCountedReplication is 0
+     */
+    bool awaitImmutable(uint64_t seqId, ImmutableCallback callback);
+
+    /**
+     * Await from any thread: the wait is posted to the thread of the face.
+     * @return a future holding the highest immutable sequence number once record @p seqId is immutable, holding a
+     * std::logic_error at once if maxCountedReplication is 0
+     */
+    std::future<uint64_t> awaitImmutable(uint64_t seqId);
+
+    /**
+     * @return the highest sequence number of @p producer's chain replicated at maxCountedReplication locations,
+     * as seen by this logger; 0 if none
+     */
+    uint64_t getImmutableSeqNo(const Name &producer) const;
+
+    /**
+     * @p recordName, the name of a record of any producer
+     */
+    bool isImmutable(const Name &recordName) const;
+
+    /**
+     * Build a proof that the record @p recordFullName is in the ledger, made of referencing records from
+     * @p producerNum other producers.
+     * @return the record, then each referencing record after the record it points to; nullopt if not available
+     */
+    std::optional<std::vector<std::shared_ptr<const Data>>>
+    getInclusionProof(const Name &recordFullName, size_t producerNum) const;
+
     const Name &getPeerPrefix() const;
 
     void setOnRecordCallback(std::function<void(const Record &)> callback) {
         m_onRecordCallback = std::move(callback);
     }
 
+    /**
+     * Set the callback called with each producer a sync update announces records of, before they are fetched.
+     */
+    void setOnSyncUpdateCallback(std::function<void(const Name &)> callback) {
+        m_onSyncUpdateCallback = std::move(callback);
+    }
+
+    /**
+     * @return the producers in the version vectors of all sync groups, including those idle since they joined
+     */
+    std::set<Name> getSyncedProducers();
+
     inline std::shared_ptr<Backend> getBackend() {
         return m_backend;
     }
@@ -68,14 +168,73 @@ class MnemosyneDagLogger {
   private:
     void onUpdate(const std::vector<ndn::svs::MissingDataInfo> &info);
 
-    void addReceivedRecord(std::unique_ptr<Record> record, const Name &producer, svs::SeqNo seqId);
+    void fetchRecord(const Name &producer, svs::SeqNo seqId);
+
+    void addReceivedRecord(const Record &record, const Name &producer, svs::SeqNo seqId);
 
     bool versionBackupCallback();
 
+    void notifyImmutableWaiters();
+
+    /**
+     * @return whether a record can be created now, after adjusting the DAG width
+     */
+    ReturnCode checkCreationReady();
+
+    /**
+     * Select the preceding records of @p record, sign it with @p seqId (0 for the next one) and add it to the ledger.
+     * @return its sequence number
+     */
+    svs::SeqNo addSelfRecord(Record &record, svs::SeqNo seqId);
+
+    void publishPendingRecords();
+
+    void postSubmissionDrain();
+
+    void drainSubmissions();
+
+    void createCheckpoint();
+
+    void scheduleCheckpoint();
+
+    void updateAgreedCheckpoint();
+
+    void scheduleAntiEntropy();
+
+    void scheduleWaitingRecordEviction();
+
+    void onCheckpointInterest(const Interest &interest);
+
+    void bootstrapFromCheckpoint(int retries);
+
+    /**
+     * Fetch the records @p recordNames of a checkpoint proof by their full names, then adopt the checkpoint if they
+     * prove it
+     */
+    void fetchCheckpointProof(const std::vector<Name> &recordNames);
+
+    void adoptCheckpoint(const std::shared_ptr<const Data> &checkpointRecord);
+
+    /**
+     * Leave the records up to the checkpoint this logger started from out of anti-entropy, as they are not stored.
+     */
+    void setAntiEntropyFloors(const svs::VersionVector &checkpointVersions);
+
+    void finishBootstrap();
+
     static ndn::svs::SecurityOptions
     getSecurityOption(KeyChain &keychain, shared_ptr<ndn::security::Validator> recordValidator, Name peerPrefix);
 
+    static std::unique_ptr<TipSelectionPolicy> getTipSelectionPolicy(const LoggerConfig &config);
+
+    /**
+     * @return the RecordSync of the sync group @p producer publishes in
+     */
+    dag::RecordSync &getGroupSync(const Name &producer);
+
     static const std::string SEQ_NO_BACKUP_KEY;
+    static const std::string AGREED_CHECKPOINT_KEY;
+    static const std::string BOOTSTRAP_CHECKPOINT_KEY;
 
   protected:
     uint64_t m_KnownSelfSeqId;
@@ -83,14 +242,57 @@ class MnemosyneDagLogger {
     std::shared_ptr<Backend> m_backend;
     std::unique_ptr<DagReferenceChecker> m_dagReferenceChecker;
     std::unique_ptr<dag::ReplicationCounter> m_replicationCounter;
+    std::unique_ptr<dag::ImmutabilityFrontier> m_immutabilityFrontier;
     ndn::svs::VersionVector m_dagCollectedVersions;
+    std::unique_ptr<dag::SyncGroups> m_syncGroups;
     std::unique_ptr<dag::RecordSync> m_dagSync;
+    // listeners of the other sync groups, indexed by group; the own group is in m_dagSync
+    std::vector<std::unique_ptr<dag::RecordSync>> m_groupListeners;
     std::function<void(const Record &)> m_onRecordCallback;
+    std::function<void(const Name &)> m_onSyncUpdateCallback;
 
-    std::unordered_map<Name, std::pair<Name, uint32_t>> m_lastRecordInChains;
+    std::unique_ptr<TipSelectionPolicy> m_lastRecordInChains;
+    std::unique_ptr<dag::WidthController> m_widthController;
+
+    // shared with the waits posted from other threads, which check that it is still alive
+    std::shared_ptr<dag::ImmutableWaiters> m_immutableWaiters;
 
     std::mt19937_64 m_randomEngine;
 
+    // checkpoints
+    security::KeyChain &m_keychain;
+    Face &m_face;
+    std::shared_ptr<ndn::security::Validator> m_recordValidator;
+    Scheduler m_scheduler;
+    scheduler::ScopedEventId m_checkpointEvent;
+    // a checkpoint due after the records arriving together, created once
+    scheduler::ScopedEventId m_checkpointCreationEvent;
+    ScopedInterestFilterHandle m_checkpointFilterHandle;
+    uint32_t m_recordsSinceCheckpoint;
+    std::list<Name> m_pendingCheckpoints;
+    std::optional<Name> m_agreedCheckpoint;
+    // the names of the agreed checkpoint record and of its proof, built on the first request for it
+    std::shared_ptr<const Data> m_checkpointResponse;
+    bool m_bootstrapping;
+    std::vector<ndn::svs::MissingDataInfo> m_bootstrapUpdates;
+
+    std::unique_ptr<dag::AntiEntropy> m_antiEntropy;
+    scheduler::ScopedEventId m_antiEntropyEvent;
+    scheduler::ScopedEventId m_waitingRecordEviction;
+
+    struct Submission {
+        Record record;
+        SubmitCallback callback;
+    };
+    // records waiting for enough tailing records, retried as records arrive and periodically
+    std::unique_ptr<dag::PendingRecords> m_pendingRecords;
+    scheduler::ScopedEventId m_pendingRecordEvent;
+    // shared with posted drains, which skip once the logger is gone
+    std::shared_ptr<dag::SubmissionQueue<Submission>> m_submissions;
+    std::atomic<bool> m_submissionDrainPosted;
+    // records created per drain, before yielding the thread to other handlers
+    static const size_t SUBMISSION_BATCH_SIZE = 64;
+
     void addPublicGenesisRecord();
 
     void restoreRecordSyncVersionVector();
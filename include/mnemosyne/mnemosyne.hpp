@@ -4,6 +4,8 @@
 #include "config.hpp"
 #include "mnemosyne/mnemosyne-dag-logger.hpp"
 #include <ndn-svs/svspubsub.hpp>
+#include <deque>
+#include <map>
 
 using namespace ndn;
 namespace mnemosyne {
@@ -11,6 +13,14 @@ namespace mnemosyne {
 namespace interface {
 class SeenEventSet;
 class SelfInsertedSet;
+
+class InsertionAssignment;
+
+class QueryService;
+
+class AdmissionQueue;
+
+class ProducerLimiter;
 }
 
 class Mnemosyne {
@@ -29,19 +39,91 @@ class Mnemosyne {
 
     virtual ~Mnemosyne();
 
+    /**
+     * Call @p callback once, when this logger's record @p seqId becomes immutable.
+     * @see MnemosyneDagLogger::awaitImmutable
+     */
+    bool awaitImmutable(uint64_t seqId, MnemosyneDagLogger::ImmutableCallback callback) {
+        return m_dagSync.awaitImmutable(seqId, std::move(callback));
+    }
+
+    std::future<uint64_t> awaitImmutable(uint64_t seqId) {
+        return m_dagSync.awaitImmutable(seqId);
+    }
+
+    /**
+     * @return whether the record @p recordName of any logger is immutable, as seen by this logger
+     */
+    bool isImmutable(const Name &recordName) const {
+        return m_dagSync.isImmutable(recordName);
+    }
+
+    /**
+     * Insert the event @p event of @p producer from any thread, bypassing the interfaces.
+     * @see MnemosyneDagLogger::submitRecord
+     */
+    ReturnCode submitEvent(const Data &event, const Name &producer, MnemosyneDagLogger::SubmitCallback callback) {
+        return m_dagSync.submitRecord(Record(event, producer), std::move(callback));
+    }
+
+    /**
+     * @return the number of client events dropped for exceeding their producer's rate
+     */
+    uint64_t getThrottledEventCount() const;
+
+    /**
+     * @return the number of client events refused or evicted by the full admission queue
+     */
+    uint64_t getDroppedEventCount() const;
+
   private:
     void onSubscriptionData(const svs::SVSPubSub::SubscriptionData &subData);
 
     void onSyncUpdate(uint32_t groupId, const std::vector<ndn::svs::MissingDataInfo> &info);
 
     void onEventData(const Data &data, const ndn::Name& producer);
-    void onEventData(const Data &data, const ndn::Name& producer, uint32_t retries);
+
+    /**
+     * Queue the event for insertion, unless it is in the DAG by now.
+     */
+    void admitEvent(const Data &data, const ndn::Name &producer);
+
+    /**
+     * Hand queued events to the DAG logger, keeping at most ADMISSION_BATCH_SIZE of them waiting there.
+     */
+    void drainAdmissionQueue();
+
+    /**
+     * Subscribe to the pubsub interfaces, and fetch the events announced on the sync interfaces while paused.
+     */
+    void subscribeInterfaces();
+
+    void pauseInterfaces();
 
     ndn::svs::SecurityOptions getSecurityOption();
 
     void onRecordUpdate(const Record &record);
 
+    void scheduleSeenEventEviction();
+
+    void scheduleSeenEventBackup();
+
+    /**
+     * Save the events seen since the last backup as a new segment, and delete the segments whose events all expired.
+     * The index lists the first and next segment, then the expiry of each in seconds since the epoch.
+     */
+    void backupSeenEvents();
+
+    /**
+     * Load the segments listed in the index, skipping those already expired.
+     */
+    void restoreSeenEvents();
+
+    std::string getSeenEventSegmentKey(uint64_t segment) const;
+
   protected:
+    static const std::string SEEN_EVENT_SEGMENT_KEY;
+    static const std::string SEEN_EVENT_INDEX_KEY;
 
     //interfaces
     std::list<svs::SVSPubSub> m_interfacePubSubs;
@@ -57,9 +139,25 @@ class Mnemosyne {
     //lower level components
     std::shared_ptr<ndn::security::Validator> m_eventValidator;
     std::unique_ptr<interface::SeenEventSet> m_seenEvents;
+    scheduler::ScopedEventId m_seenEventEviction;
+    scheduler::ScopedEventId m_seenEventBackup;
+    uint64_t m_seenEventsBackedUp;
+    // backed up segments from m_firstSeenEventSegment on, with the wall clock time their events all expire
+    uint64_t m_firstSeenEventSegment;
+    std::deque<std::chrono::system_clock::time_point> m_seenEventSegmentExpiry;
     std::unique_ptr<interface::SelfInsertedSet> m_selfInsertEventProducers;
+    std::unique_ptr<interface::InsertionAssignment> m_insertionAssignment;
+    std::unique_ptr<interface::ProducerLimiter> m_producerLimiter;
+    std::unique_ptr<interface::AdmissionQueue> m_admissionQueue;
+    scheduler::ScopedEventId m_admissionDrainEvent;
+    std::vector<uint32_t> m_subscriptionHandles;
+    bool m_interfacesPaused;
+    // per interface sync group, the range of sequence numbers of each node announced while paused
+    std::map<uint32_t, std::map<svs::NodeID, std::pair<svs::SeqNo, svs::SeqNo>>> m_missedSyncUpdates;
+    static const size_t ADMISSION_BATCH_SIZE;
     uint64_t m_lastImmutableSeqNo;
     MnemosyneDagLogger m_dagSync;
+    std::unique_ptr<interface::QueryService> m_queryService;
 };
 
 } // namespace mnemosyne
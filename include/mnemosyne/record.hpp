@@ -100,6 +100,13 @@ class Record {
     void
     checkPointerCount(uint32_t numPointers) const;
 
+    /**
+     * validate the pointers in a header, whose number may be adapted within bounds by the producer.
+     * @note This function is supposed to be used by the Mnemosyne DAG class only
+     */
+    void
+    checkPointerCount(uint32_t minPointers, uint32_t maxPointers) const;
+
     /**
      * Encode the record header and body into the block.
      * @p block, output, the Data Content block to carry the encoded record.
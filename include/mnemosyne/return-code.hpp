@@ -13,7 +13,8 @@ enum ErrorCode {
     EC_NoTailingRecord = 1,
     EC_NotEnoughTailingRecord = 2,
     EC_SigningError = 3,
-    EC_TimingError = 4
+    EC_TimingError = 4,
+    EC_QueueFull = 5
 };
 
 class ReturnCode {
@@ -36,6 +37,8 @@ class ReturnCode {
 
     static ReturnCode timingError(const std::string &reason) { return ReturnCode(EC_TimingError, reason); }
 
+    static ReturnCode queueFull() { return ReturnCode(EC_QueueFull, "Submission Queue Full"); }
+
 
     bool success() { return m_errorCode == EC_OK; }
 
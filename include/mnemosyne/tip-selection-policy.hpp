@@ -0,0 +1,50 @@
+#ifndef MNEMOSYNE_INCLUDE_TIP_SELECTION_POLICY_H_
+#define MNEMOSYNE_INCLUDE_TIP_SELECTION_POLICY_H_
+
+#include "record.hpp"
+#include <ndn-cxx/name.hpp>
+#include <random>
+
+namespace mnemosyne {
+
+/**
+ * The strategy for choosing the preceding records of a new record.
+ * It keeps the last record in each producer's chain that may still be referenced (the tailing records),
+ * and the number of times this logger may still reference each of them.
+ */
+class TipSelectionPolicy {
+  public:
+    virtual ~TipSelectionPolicy() = default;
+
+    virtual size_t size() const = 0;
+
+    virtual bool contains(const ndn::Name &producer) const = 0;
+
+    /**
+     * @throw std::out_of_range if the producer has no tailing record
+     */
+    virtual const ndn::Name &getRecord(const ndn::Name &producer) const = 0;
+
+    /**
+     * Set the tailing record of a producer, replacing the previous one.
+     */
+    virtual void update(const ndn::Name &producer, const ndn::Name &recordFullName, uint32_t refCount) = 0;
+
+    virtual void erase(const ndn::Name &producer) = 0;
+
+    /**
+     * Add @p num tailing records of distinct producers to @p record as preceding records.
+     * The remaining count of each selected tail is decreased, and it is removed once exhausted.
+     * @pre size() >= num
+     */
+    virtual void selectInto(Record &record, size_t num, std::mt19937_64 &randomEngine) = 0;
+
+    /**
+     * Notify the policy of a record added to the ledger, after the tail of its producer is updated.
+     */
+    virtual void onRecordAccepted(const Record &record) {}
+};
+
+} // namespace mnemosyne
+
+#endif // MNEMOSYNE_INCLUDE_TIP_SELECTION_POLICY_H_
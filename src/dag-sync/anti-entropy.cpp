@@ -0,0 +1,290 @@
+#include "anti-entropy.h"
+#include "mnemosyne/record.hpp"
+
+#include <ndn-cxx/encoding/block-helpers.hpp>
+#include <ndn-cxx/security/signing-helpers.hpp>
+#include <ndn-cxx/util/logger.hpp>
+#include <algorithm>
+
+NDN_LOG_INIT(mnemosyne.dagsync.antiEntropy);
+
+namespace mnemosyne::dag {
+
+AntiEntropy::AntiEntropy(Face &face, KeyChain &keychain, std::shared_ptr<security::Validator> validator,
+                         const Name &hintPrefix, const Name &peerPrefix, MissingRecordCallback onMissingRecord) :
+        m_face(face),
+        m_keychain(keychain),
+        m_validator(std::move(validator)),
+        m_hintPrefix(hintPrefix),
+        m_peerPrefix(peerPrefix),
+        m_onMissingRecord(std::move(onMissingRecord)) {
+    m_peerFilterHandle = m_face.setInterestFilter(Name(m_hintPrefix).append("AE").append("PEER"),
+                                                  [this](auto &&...) { onPeerInterest(); });
+    m_summaryFilterHandle = m_face.setInterestFilter(Name(m_peerPrefix).append("AE").append("SUMMARY"),
+                                                     [this](auto &&, const auto &interest) {
+                                                         onSummaryInterest(interest);
+                                                     });
+    m_nodeFilterHandle = m_face.setInterestFilter(Name(m_peerPrefix).append("AE").append("NODE"),
+                                                  [this](auto &&, const auto &interest) {
+                                                      onNodeInterest(interest);
+                                                  });
+}
+
+void AntiEntropy::addRecord(const Name &recordFullName) {
+    if (recordFullName.empty() || !recordFullName.get(-1).isImplicitSha256Digest()) return;
+    const auto &component = recordFullName.get(-1);
+    MerkleRangeTree::Digest digest;
+    if (component.value_size() != digest.size()) return;
+    std::copy_n(component.value(), digest.size(), digest.begin());
+    m_trees[Record::getProducerPrefix(recordFullName)].set(Record::getRecordSeqId(recordFullName), digest);
+}
+
+void AntiEntropy::setFloor(const Name &producer, uint64_t seqId) {
+    auto &floor = m_floors[producer];
+    floor = std::max(floor, seqId);
+}
+
+void AntiEntropy::reconcile() {
+    Interest interest(Name(m_hintPrefix).append("AE").append("PEER"));
+    interest.setCanBePrefix(true);
+    interest.setMustBeFresh(true);
+    interest.setInterestLifetime(time::seconds(2));
+    m_face.expressInterest(interest, [this](const Interest &, const Data &data) { onPeer(data); },
+                           [](const Interest &interest, auto &&) {
+                               NDN_LOG_DEBUG("Nack on " << interest.getName());
+                           },
+                           [](auto &&) {
+                               NDN_LOG_DEBUG("No anti-entropy peer found");
+                           });
+}
+
+void AntiEntropy::onPeerInterest() {
+    // only tells where to ask for the summary, which is validated as the peer's own
+    Data response(Name(m_hintPrefix).append("AE").append("PEER").appendVersion());
+    response.setContent(m_peerPrefix.wireEncode());
+    response.setFreshnessPeriod(time::seconds(1));
+    m_keychain.sign(response, security::signingByIdentity(m_peerPrefix));
+    m_face.put(response);
+}
+
+void AntiEntropy::onSummaryInterest(const Interest &interest) {
+    const auto &name = interest.getName();
+    auto offset = m_peerPrefix.size() + 2;
+    if (name.size() <= offset) return;
+    std::optional<Name> after;
+    try {
+        const auto &component = name.get(offset);
+        if (component.value_size() > 0) after = Name(Block(make_span(component.value(), component.value_size())));
+    } catch (const std::exception &e) {
+        NDN_LOG_DEBUG("Bad anti-entropy Interest " << name << ": " << e.what());
+        return;
+    }
+
+    auto content = makeEmptyBlock(tlv::Content);
+    size_t size = 0;
+    auto it = after ? m_trees.upper_bound(*after) : m_trees.begin();
+    for (; it != m_trees.end(); it++) {
+        const auto &[producer, tree] = *it;
+        auto summary = makeEmptyBlock(T_ProducerSummary);
+        summary.push_back(producer.wireEncode());
+        summary.push_back(makeNonNegativeIntegerBlock(T_Height, tree.getHeight()));
+        summary.push_back(makeDigestBlock(tree.get(tree.getHeight(), 0)));
+        auto floor = getFloor(producer);
+        if (floor > 0) summary.push_back(makeNonNegativeIntegerBlock(T_Floor, floor));
+        summary.encode();
+        // each page takes at least one producer, so that the pages always advance
+        if (size > 0 && size + summary.size() > MAX_SUMMARY_SIZE) break;
+        size += summary.size();
+        content.push_back(summary);
+    }
+    if (it != m_trees.end()) content.push_back(makeEmptyBlock(T_More));
+    content.encode();
+
+    Data response(Name(name.getPrefix(offset + 1)).appendVersion());
+    response.setContent(content);
+    response.setFreshnessPeriod(time::seconds(1));
+    m_keychain.sign(response, security::signingByIdentity(m_peerPrefix));
+    m_face.put(response);
+}
+
+void AntiEntropy::onNodeInterest(const Interest &interest) {
+    const auto &name = interest.getName();
+    auto offset = m_peerPrefix.size() + 2;
+    if (name.size() <= offset + 2) return;
+    size_t level;
+    uint64_t index;
+    try {
+        level = name.get(offset).toNumber();
+        index = name.get(offset + 1).toNumber();
+    } catch (const std::exception &e) {
+        NDN_LOG_DEBUG("Bad anti-entropy Interest " << name << ": " << e.what());
+        return;
+    }
+    if (level == 0 || level > MAX_LEVEL) return;
+    auto producer = name.getSubName(offset + 2);
+
+    auto content = makeEmptyBlock(tlv::Content);
+    content.push_back(makeDigestBlock(getTree(producer).get(level - 1, 2 * index)));
+    content.push_back(makeDigestBlock(getTree(producer).get(level - 1, 2 * index + 1)));
+    content.encode();
+
+    Data response(name);
+    response.setContent(content);
+    response.setFreshnessPeriod(time::seconds(1));
+    m_keychain.sign(response, security::signingByIdentity(m_peerPrefix));
+    m_face.put(response);
+}
+
+void AntiEntropy::onPeer(const Data &data) {
+    Name peer;
+    try {
+        peer = Name(data.getContent().blockFromValue());
+    } catch (const std::exception &e) {
+        NDN_LOG_ERROR("Bad anti-entropy peer " << data.getName() << ": " << e.what());
+        return;
+    }
+    if (peer.empty() || peer == m_peerPrefix) return;
+    requestSummary(peer, std::nullopt);
+}
+
+void AntiEntropy::requestSummary(const Name &peer, const std::optional<Name> &after) {
+    Name name = Name(peer).append("AE").append("SUMMARY");
+    if (after) {
+        const auto &wire = after->wireEncode();
+        name.append(name::Component(make_span(wire.wire(), wire.size())));
+    } else {
+        name.append(name::Component());
+    }
+    Interest interest(name);
+    interest.setCanBePrefix(true);
+    interest.setMustBeFresh(true);
+    interest.setInterestLifetime(time::seconds(2));
+    m_face.expressInterest(interest, [this, peer](const Interest &, const Data &data) {
+                               validate(data, [this, peer](const Data &data) { onSummary(peer, data); });
+                           },
+                           [](const Interest &interest, auto &&) {
+                               NDN_LOG_DEBUG("Nack on " << interest.getName());
+                           },
+                           [](const Interest &interest) {
+                               NDN_LOG_DEBUG("Timeout on " << interest.getName());
+                           });
+}
+
+void AntiEntropy::onSummary(const Name &peer, const Data &data) {
+    std::vector<std::tuple<Name, size_t, MerkleRangeTree::Digest, uint64_t>> summaries;
+    bool more = false;
+    try {
+        const auto &content = data.getContent();
+        content.parse();
+        for (const auto &element: content.elements()) {
+            if (element.type() == T_More) more = true;
+            if (element.type() != T_ProducerSummary) continue;
+            element.parse();
+            auto floor = element.find(T_Floor);
+            summaries.emplace_back(Name(element.get(tlv::Name)), readNonNegativeInteger(element.get(T_Height)),
+                                   readDigest(element.get(T_Digest)),
+                                   floor == element.elements_end() ? 0 : readNonNegativeInteger(*floor));
+        }
+    } catch (const std::exception &e) {
+        NDN_LOG_ERROR("Bad anti-entropy summary " << data.getName() << ": " << e.what());
+        return;
+    }
+
+    for (const auto &[producer, remoteHeight, remoteRoot, remoteFloor]: summaries) {
+        if (remoteHeight > MAX_LEVEL) continue;
+        auto floor = std::max(getFloor(producer), remoteFloor);
+        auto step = RangeReconciler::compareRoot(getTree(producer), floor, remoteHeight, remoteRoot);
+        if (step.requests.empty()) continue;
+        NDN_LOG_DEBUG("Chain of " << producer << " differs from " << peer << " above " << floor);
+        proceed(peer, producer, floor, step);
+    }
+    // the producers of a page follow those of the previous one, so an empty page would not advance
+    if (more && !summaries.empty()) requestSummary(peer, std::get<0>(summaries.back()));
+}
+
+void AntiEntropy::requestChildren(const Name &peer, const Name &producer, uint64_t floor, size_t level,
+                                  uint64_t index) {
+    Interest interest(Name(peer).append("AE").append("NODE").appendNumber(level).appendNumber(index)
+                              .append(producer));
+    interest.setMustBeFresh(true);
+    interest.setInterestLifetime(time::seconds(2));
+    m_face.expressInterest(interest, [=](const Interest &, const Data &data) {
+                               validate(data, [=](const Data &data) {
+                                   onChildren(peer, producer, floor, level, index, data);
+                               });
+                           },
+                           [](const Interest &interest, auto &&) {
+                               NDN_LOG_DEBUG("Nack on " << interest.getName());
+                           },
+                           [](const Interest &interest) {
+                               NDN_LOG_DEBUG("Timeout on " << interest.getName());
+                           });
+}
+
+void AntiEntropy::onChildren(const Name &peer, const Name &producer, uint64_t floor, size_t level, uint64_t index,
+                             const Data &data) {
+    std::vector<MerkleRangeTree::Digest> children;
+    try {
+        const auto &content = data.getContent();
+        content.parse();
+        for (const auto &element: content.elements()) {
+            children.push_back(readDigest(element));
+        }
+    } catch (const std::exception &e) {
+        NDN_LOG_ERROR("Bad anti-entropy node " << data.getName() << ": " << e.what());
+        return;
+    }
+    if (children.size() != 2) return;
+    proceed(peer, producer, floor, RangeReconciler::compareChildren(getTree(producer), floor, level, index,
+                                                                    {children[0], children[1]}));
+}
+
+void AntiEntropy::proceed(const Name &peer, const Name &producer, uint64_t floor, const RangeReconciler::Step &step) {
+    for (const auto &node: step.requests) {
+        requestChildren(peer, producer, floor, node.level, node.index);
+    }
+    for (auto seqId: step.missing) {
+        NDN_LOG_DEBUG("Missing " << Record::getRecordName(producer, seqId) << " found at " << peer);
+        m_onMissingRecord(producer, seqId);
+    }
+    for (auto seqId: step.conflicting) {
+        NDN_LOG_WARN("Conflicting digests for " << Record::getRecordName(producer, seqId) << " reported by " << peer);
+    }
+}
+
+void AntiEntropy::validate(const Data &data, std::function<void(const Data &)> onValidated) {
+    if (!m_validator) {
+        onValidated(data);
+        return;
+    }
+    m_validator->validate(data, [onValidated = std::move(onValidated)](const Data &data) { onValidated(data); },
+                          [](const Data &data, const security::ValidationError &error) {
+                              NDN_LOG_ERROR("Invalid anti-entropy reply " << data.getName() << ": " << error);
+                          });
+}
+
+const MerkleRangeTree &AntiEntropy::getTree(const Name &producer) const {
+    static const MerkleRangeTree empty;
+    auto it = m_trees.find(producer);
+    return it == m_trees.end() ? empty : it->second;
+}
+
+uint64_t AntiEntropy::getFloor(const Name &producer) const {
+    auto it = m_floors.find(producer);
+    return it == m_floors.end() ? 0 : it->second;
+}
+
+Block AntiEntropy::makeDigestBlock(const MerkleRangeTree::Digest &digest) {
+    return makeBinaryBlock(T_Digest, digest);
+}
+
+MerkleRangeTree::Digest AntiEntropy::readDigest(const Block &block) {
+    MerkleRangeTree::Digest digest;
+    if (block.type() != T_Digest || block.value_size() != digest.size()) {
+        NDN_THROW(std::runtime_error("Bad digest"));
+    }
+    std::copy_n(block.value(), digest.size(), digest.begin());
+    return digest;
+}
+
+} // namespace mnemosyne::dag
@@ -0,0 +1,120 @@
+#ifndef MNEMOSYNE_ANTI_ENTROPY_H
+#define MNEMOSYNE_ANTI_ENTROPY_H
+
+#include "merkle-range-tree.h"
+#include "range-reconciler.h"
+#include <ndn-cxx/face.hpp>
+#include <ndn-cxx/security/key-chain.hpp>
+#include <ndn-cxx/security/validator.hpp>
+#include <functional>
+#include <map>
+#include <optional>
+
+namespace mnemosyne::dag {
+
+/**
+ * Reconcile the records stored by this logger with those of another logger, after a partition for example.
+ *
+ * Each logger summarizes every producer's chain with a MerkleRangeTree of record digests.
+ * A round asks any peer under <hint-prefix>/AE/PEER for its name, then pages through its root per producer at
+ * <peer-prefix>/AE/SUMMARY/<after>, where <after> holds the wire encoding of the last producer of the previous page
+ * and is empty on the first, and descends through <peer-prefix>/AE/NODE/<level>/<index>/<producer> into the ranges
+ * whose hashes differ only, so its cost grows with the difference rather than the ledger.
+ * The summary pages and the nodes are named under the peer, so that they are validated with the record validator
+ * before they are acted upon.
+ * Records the peer has and this logger does not are reported to be fetched; different digests under the same
+ * sequence number are logged as conflicting.
+ * Each summary carries the producer's floor, the sequence number of the checkpoint the logger started from, and a
+ * round leaves out the records up to the higher floor of both sides, which one of them does not store.
+ */
+class AntiEntropy {
+  public:
+    using MissingRecordCallback = std::function<void(const ndn::Name &producer, uint64_t seqId)>;
+
+    /**
+     * @p validator, the validator of the records of other loggers; the replies of peers are not validated if null
+     */
+    AntiEntropy(ndn::Face &face, ndn::KeyChain &keychain, std::shared_ptr<ndn::security::Validator> validator,
+                const ndn::Name &hintPrefix, const ndn::Name &peerPrefix, MissingRecordCallback onMissingRecord);
+
+    /**
+     * @p recordFullName, the full name of a record stored in the ledger
+     */
+    void addRecord(const ndn::Name &recordFullName);
+
+    /**
+     * Leave out the records of @p producer up to @p seqId, which this logger does not store.
+     */
+    void setFloor(const ndn::Name &producer, uint64_t seqId);
+
+    /**
+     * Start a reconciliation round with a peer reached through the hint prefix.
+     */
+    void reconcile();
+
+  private:
+    void onPeerInterest();
+
+    void onSummaryInterest(const ndn::Interest &interest);
+
+    void onNodeInterest(const ndn::Interest &interest);
+
+    void onPeer(const ndn::Data &data);
+
+    void requestSummary(const ndn::Name &peer, const std::optional<ndn::Name> &after);
+
+    void onSummary(const ndn::Name &peer, const ndn::Data &data);
+
+    void requestChildren(const ndn::Name &peer, const ndn::Name &producer, uint64_t floor, size_t level,
+                         uint64_t index);
+
+    void onChildren(const ndn::Name &peer, const ndn::Name &producer, uint64_t floor, size_t level, uint64_t index,
+                    const ndn::Data &data);
+
+    /**
+     * Request the nodes and report the records that @p step found.
+     */
+    void proceed(const ndn::Name &peer, const ndn::Name &producer, uint64_t floor, const RangeReconciler::Step &step);
+
+    const MerkleRangeTree &getTree(const ndn::Name &producer) const;
+
+    uint64_t getFloor(const ndn::Name &producer) const;
+
+    /**
+     * Call @p onValidated with @p data once it is validated.
+     */
+    void validate(const ndn::Data &data, std::function<void(const ndn::Data &)> onValidated);
+
+    static ndn::Block makeDigestBlock(const MerkleRangeTree::Digest &digest);
+
+    static MerkleRangeTree::Digest readDigest(const ndn::Block &block);
+
+  private:
+    const static uint8_t T_ProducerSummary = 140;
+    const static uint8_t T_Height = 141;
+    const static uint8_t T_Digest = 142;
+    // ends a summary page that is followed by another
+    const static uint8_t T_More = 143;
+    const static uint8_t T_Floor = 144;
+    // content bytes past which a summary page takes no more producers, so that it fits a packet
+    const static size_t MAX_SUMMARY_SIZE = 7000;
+    // bound on the levels a peer can ask for, well above any chain length
+    const static size_t MAX_LEVEL = 64;
+
+    ndn::Face &m_face;
+    ndn::KeyChain &m_keychain;
+    std::shared_ptr<ndn::security::Validator> m_validator;
+    ndn::Name m_hintPrefix;
+    ndn::Name m_peerPrefix;
+    MissingRecordCallback m_onMissingRecord;
+    // ordered by producer, so that the summary is paged
+    std::map<ndn::Name, MerkleRangeTree> m_trees;
+    std::map<ndn::Name, uint64_t> m_floors;
+    ndn::ScopedInterestFilterHandle m_peerFilterHandle;
+    ndn::ScopedInterestFilterHandle m_summaryFilterHandle;
+    ndn::ScopedInterestFilterHandle m_nodeFilterHandle;
+};
+
+} // namespace mnemosyne::dag
+
+#endif //MNEMOSYNE_ANTI_ENTROPY_H
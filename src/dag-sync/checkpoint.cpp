@@ -0,0 +1,86 @@
+#include "checkpoint.h"
+
+#include <algorithm>
+#include <set>
+#include <unordered_set>
+
+namespace mnemosyne::dag {
+
+bool Checkpoint::isCheckpointName(const Name &name) {
+    if (name.size() < 2 || !name.get(-1).isVersion()) return false;
+    return readString(name.get(-2)) == "CHECKPOINT";
+}
+
+bool Checkpoint::isCheckpointOf(const Name &name, const Name &producer) {
+    return name.size() == producer.size() + 2 && producer.isPrefixOf(name) && isCheckpointName(name);
+}
+
+Name Checkpoint::makeCheckpointName(const Name &producer) {
+    return Name(producer).append("CHECKPOINT").appendVersion();
+}
+
+Checkpoint::Checkpoint(svs::VersionVector versions, std::vector<Name> tips)
+        : m_versions(std::move(versions)),
+          m_tips(std::move(tips)) {
+}
+
+Checkpoint::Checkpoint(const Data &data) {
+    if (!isCheckpointName(data.getName()))
+        NDN_THROW(std::runtime_error("Bad checkpoint name: " + data.getName().toUri()));
+    const auto &content = data.getContent();
+    content.parse();
+    if (content.elements_size() != 2 || content.elements().back().type() != T_CheckpointTips)
+        NDN_THROW(std::runtime_error("Bad checkpoint content: " + data.getName().toUri()));
+    m_versions = svs::VersionVector(content.elements().front());
+    const auto &tips = content.elements().back();
+    tips.parse();
+    for (const auto &tip: tips.elements()) {
+        m_tips.emplace_back(tip);
+        if (!Record::isRecordName(m_tips.back()))
+            NDN_THROW(std::runtime_error("Bad checkpoint tip: " + m_tips.back().toUri()));
+    }
+}
+
+void Checkpoint::wireEncode(Block &block) const {
+    block.push_back(m_versions.encode());
+    Block tips(T_CheckpointTips);
+    for (const auto &tip: m_tips) {
+        tips.push_back(tip.wireEncode());
+    }
+    tips.encode();
+    block.push_back(tips);
+    block.encode();
+}
+
+bool Checkpoint::verifyProof(const std::vector<std::shared_ptr<const Data>> &proof, size_t producerNum) {
+    if (proof.empty()) return false;
+    try {
+        Record checkpointRecord(proof.front());
+        auto checkpointProducer = Record::getProducerPrefix(proof.front()->getName());
+        if (!checkpointRecord.getContentData() ||
+            !isCheckpointOf(checkpointRecord.getContentData()->getName(), checkpointProducer))
+            return false;
+        // a checkpoint summarizes the DAG before the record carrying it
+        Checkpoint checkpoint(*checkpointRecord.getContentData());
+        if (checkpoint.getVersions().get(checkpointProducer) >= Record::getRecordSeqId(proof.front()->getName()))
+            return false;
+
+        std::unordered_set<Name> provenRecords{proof.front()->getFullName()};
+        std::set<Name> producers;
+        for (size_t i = 1; i < proof.size(); i++) {
+            Record record(proof[i]);
+            const auto &pointers = record.getPointersFromHeader();
+            if (std::none_of(pointers.begin(), pointers.end(),
+                             [&](const Name &pointer) { return provenRecords.count(pointer) != 0; }))
+                return false;
+            provenRecords.insert(proof[i]->getFullName());
+            auto producer = Record::getProducerPrefix(proof[i]->getName());
+            if (producer != checkpointProducer) producers.insert(producer);
+        }
+        return producers.size() >= producerNum;
+    } catch (const std::exception &e) {
+        return false;
+    }
+}
+
+} // namespace mnemosyne::dag
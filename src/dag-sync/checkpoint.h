@@ -0,0 +1,70 @@
+#ifndef MNEMOSYNE_CHECKPOINT_H
+#define MNEMOSYNE_CHECKPOINT_H
+
+#include "mnemosyne/record.hpp"
+#include <ndn-cxx/data.hpp>
+#include <ndn-svs/version-vector.hpp>
+#include <vector>
+
+namespace mnemosyne::dag {
+
+/**
+ * A summary of the DAG carried as the event of a record: the version vector of the producing logger and the full
+ * names of the last record of each producer in it.
+ * Checkpoint Name: /<producer-prefix>/CHECKPOINT/<version>
+ * Once the record carrying a checkpoint is replicated at enough loggers, a new logger can start from it instead of
+ * fetching the records before it.
+ */
+class Checkpoint {
+  public:
+    static bool isCheckpointName(const ndn::Name &name);
+
+    /**
+     * @return whether @p name is the name of a checkpoint issued by @p producer, as a client event may take any name
+     */
+    static bool isCheckpointOf(const ndn::Name &name, const ndn::Name &producer);
+
+    static ndn::Name makeCheckpointName(const ndn::Name &producer);
+
+    Checkpoint(ndn::svs::VersionVector versions, std::vector<ndn::Name> tips);
+
+    /**
+     * Decode the checkpoint carried in a checkpoint Data.
+     * @throw std::runtime_error if the Data is not a checkpoint or a tip is not a record name
+     */
+    explicit Checkpoint(const ndn::Data &data);
+
+    /**
+     * Encode the checkpoint into the Data Content block.
+     */
+    void wireEncode(ndn::Block &block) const;
+
+    const ndn::svs::VersionVector &getVersions() const {
+        return m_versions;
+    }
+
+    const std::vector<ndn::Name> &getTips() const {
+        return m_tips;
+    }
+
+    /**
+     * Check that @p proof is a record carrying a checkpoint of its own producer followed by records that each reference
+     * an earlier one, from at least @p producerNum producers other than the checkpoint's, as built by
+     * buildInclusionProof.
+     * Signatures are not checked.
+     */
+    static bool verifyProof(const std::vector<std::shared_ptr<const ndn::Data>> &proof, size_t producerNum);
+
+  private:
+    /**
+     * The TLV type of the tip list in the checkpoint Data Content.
+     */
+    const static uint8_t T_CheckpointTips = 131;
+
+    ndn::svs::VersionVector m_versions;
+    std::vector<ndn::Name> m_tips;
+};
+
+} // namespace mnemosyne::dag
+
+#endif //MNEMOSYNE_CHECKPOINT_H
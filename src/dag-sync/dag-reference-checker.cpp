@@ -12,62 +12,209 @@ NDN_LOG_INIT(mnemosyne.dagsync.refChecker);
 using namespace ndn;
 namespace mnemosyne {
 
-void DagReferenceChecker::verifyPreviousRecord(std::unique_ptr<Record> record, const Name &producer, svs::SeqNo seqId) {
+const std::string DagReferenceChecker::SPILL_KEY_PREFIX = "WaitingRecord";
+
+DagReferenceChecker::DagReferenceChecker(std::weak_ptr<Backend> backend,
+                                         std::function<void(std::unique_ptr<Record>, const Name &,
+                                                            svs::SeqNo)> readyRecordCallback,
+                                         size_t memoryLimit, std::chrono::seconds waitingTimeout,
+                                         size_t recentRecordCacheSize) :
+        m_backend(std::move(backend)),
+        m_readyRecordCallback(std::move(readyRecordCallback)),
+        m_memoryLimit(memoryLimit),
+        m_memoryUsage(0),
+        m_waitingTimeout(waitingTimeout),
+        m_recentRecords(recentRecordCacheSize) {
+    auto locked = m_backend.lock();
+    if (locked) {
+        purgeSpilledRecords(*locked);
+    }
+}
+
+void DagReferenceChecker::addAcceptedRecord(const Name &recordFullName) {
+    m_recentRecords.insert(recordFullName);
+}
+
+void DagReferenceChecker::setCheckpoint(svs::VersionVector versions) {
+    m_checkpoint = std::move(versions);
+}
+
+void DagReferenceChecker::setMissingRecordCallback(std::function<void(const Name &)> callback) {
+    m_missingRecordCallback = std::move(callback);
+}
+
+void DagReferenceChecker::evictExpired() {
+    auto backend = m_backend.lock();
+    if (backend) {
+        evictExpiredRecords(*backend);
+    }
+}
+
+void DagReferenceChecker::addRecord(std::unique_ptr<Record> record, const Name &name, svs::SeqNo seqId) {
     auto backend = m_backend.lock();
     if (!backend) {
         NDN_LOG_ERROR("Backend freed but dag checker called");
         return;
     }
-    auto recordName = record->getRecordFullName();
-    for (const auto &i: record->getPointersFromHeader()) {
+    evictExpiredRecords(*backend);
+
+    // records unblocked by an accepted record are checked in turn instead of recursively
+    std::queue<RecordItem> worklist;
+    worklist.emplace(std::move(record), name, seqId);
+    while (!worklist.empty()) {
+        auto item = std::move(worklist.front());
+        worklist.pop();
+        auto &current = std::get<0>(item);
+        auto recordName = current->getRecordFullName();
+
+        std::optional<Name> missing;
+        try {
+            missing = findMissingPrecedingRecord(*current, *backend);
+        } catch (const std::runtime_error &e) {
+            NDN_LOG_ERROR(e.what());
+            continue;
+        }
+        if (missing) {
+            NDN_LOG_DEBUG("record " << recordName << " waiting for " << *missing);
+            addWaitingRecord(std::move(item), *missing, *backend);
+            continue;
+        }
+
+        //verification success
+        NDN_LOG_DEBUG("record checked for reference: " << recordName);
+        m_readyRecordCallback(std::move(current), std::get<1>(item), std::get<2>(item));
+        releaseWaitingRecords(recordName, *backend, worklist);
+    }
+}
+
+std::optional<Name>
+DagReferenceChecker::findMissingPrecedingRecord(const Record &record, const Backend &backend) const {
+    for (const auto &i: record.getPointersFromHeader()) {
         if (!Record::isRecordName(i) || !i.get(-1).isImplicitSha256Digest()) {
-            NDN_LOG_ERROR("Bad preceding record: " << i << " in " << record->getRecordFullName());
-            return;
+            NDN_THROW(std::runtime_error("Bad preceding record: " + i.toUri() + " in " +
+                                         record.getRecordFullName().toUri()));
         }
         if (Record::isGenesisRecord(i)) {
             if (i == Record::getGenesisRecordFullName(i.getPrefix(-1))) continue;
-            else {
-                NDN_LOG_ERROR("Bad genesis preceding record: " << i << " in " << record->getRecordFullName());
-                return;
-            }
-        } else if (m_waitingRecords.count(i) || !backend->getRecord(i)) { //verification failed
-            m_targetForWaitingRecords.emplace(i, recordName);
-            m_waitingRecords.emplace(recordName, std::tuple(std::move(record), producer, seqId));
-            NDN_LOG_DEBUG("record " << recordName << " waiting for " << i);
-            return;
+            NDN_THROW(std::runtime_error("Bad genesis preceding record: " + i.toUri() + " in " +
+                                         record.getRecordFullName().toUri()));
+        }
+        if (m_recentRecords.contains(i)) continue;
+        if (Record::getRecordSeqId(i) <= m_checkpoint.get(Record::getProducerPrefix(i))) continue;
+        if (m_waitingRecords.count(i) || !backend.getRecord(i)) {
+            return i;
         }
     }
+    return std::nullopt;
+}
+
+void DagReferenceChecker::addWaitingRecord(RecordItem item, const Name &waitingFor, Backend &backend) {
+    auto &[record, producer, seqId] = item;
+    auto recordName = record->getRecordFullName();
+    if (m_waitingRecords.count(recordName)) return;
+
+    const auto &wire = record->getEncodedData()->wireEncode();
+    WaitingRecord waiting{nullptr, producer, seqId, waitingFor, std::chrono::steady_clock::now(), wire.size()};
+    if (m_memoryUsage + waiting.size > m_memoryLimit &&
+        backend.placeMetaData(getSpillKey(recordName), std::string((const char *) wire.wire(), wire.size()))) {
+        NDN_LOG_DEBUG("record " << recordName << " moved to backend while waiting");
+    } else {
+        waiting.record = std::move(record);
+        m_memoryUsage += waiting.size;
+    }
 
-    //verification success
-    NDN_LOG_DEBUG("record checked for reference: " << record->getEncodedData()->getFullName());
-    m_readyRecordCallback(std::move(record), producer, seqId);
-
-    std::map<Name, std::tuple<std::unique_ptr<Record>, Name, svs::SeqNo>> waitingList;
-    if (m_targetForWaitingRecords.count(recordName) > 0) {
-        for (auto it = m_targetForWaitingRecords.find(recordName);
-             it->first == recordName; m_targetForWaitingRecords.erase(it++)) {
-            auto record_it = m_waitingRecords.find(it->second);
-            if (record_it == m_waitingRecords.end()) continue;
-            waitingList.emplace(record_it->first, std::move(record_it->second));
-            m_waitingRecords.erase(record_it);
+    m_targetForWaitingRecords.emplace(waitingFor, recordName);
+    m_expiryQueue.emplace(waiting.arrival, recordName);
+    m_waitingRecords.emplace(recordName, std::move(waiting));
+    if (m_missingRecordCallback && m_targetForWaitingRecords.count(waitingFor) == 1) {
+        m_missingRecordCallback(waitingFor);
+    }
+}
+
+void DagReferenceChecker::releaseWaitingRecords(const Name &recordName, Backend &backend,
+                                                std::queue<RecordItem> &worklist) {
+    auto [begin, end] = m_targetForWaitingRecords.equal_range(recordName);
+    for (auto it = begin; it != end; it++) {
+        auto record_it = m_waitingRecords.find(it->second);
+        if (record_it == m_waitingRecords.end()) continue;
+        auto &waiting = record_it->second;
+        auto record = takeWaitingRecord(record_it->first, waiting, backend);
+        if (record) {
+            worklist.emplace(std::move(record), std::move(waiting.producer), waiting.seqId);
         }
+        m_waitingRecords.erase(record_it);
     }
+    m_targetForWaitingRecords.erase(begin, end);
+}
 
-    for (auto &[name, p]: waitingList) {
-        verifyPreviousRecord(std::move(std::get<0>(p)), std::get<1>(p), std::get<2>(p));
+std::unique_ptr<Record>
+DagReferenceChecker::takeWaitingRecord(const Name &recordName, WaitingRecord &waiting, Backend &backend) {
+    if (waiting.record) {
+        m_memoryUsage -= waiting.size;
+        return std::move(waiting.record);
+    }
+
+    auto key = getSpillKey(recordName);
+    auto page = backend.getMetaData(key);
+    backend.deleteMetaData(key);
+    if (!page) {
+        NDN_LOG_ERROR("waiting record " << recordName << " missing in backend");
+        return nullptr;
+    }
+    try {
+        ndn::Block block(make_span(reinterpret_cast<const uint8_t *>(page->data()), page->size()));
+        return std::make_unique<Record>(std::make_shared<Data>(block));
+    } catch (const std::exception &e) {
+        NDN_LOG_ERROR("waiting record " << recordName << " restore failed: " << e.what());
+        return nullptr;
     }
 }
 
-DagReferenceChecker::DagReferenceChecker(std::weak_ptr<Backend> backend,
-                                         std::function<void(std::unique_ptr<Record>, const Name &,
-                                                            svs::SeqNo)> readyRecordCallback) :
-        m_backend(std::move(backend)),
-        m_readyRecordCallback(std::move(readyRecordCallback)) {
+void DagReferenceChecker::evictExpiredRecords(Backend &backend) {
+    auto deadline = std::chrono::steady_clock::now() - m_waitingTimeout;
+    while (!m_expiryQueue.empty() && m_expiryQueue.front().first <= deadline) {
+        auto [arrival, recordName] = std::move(m_expiryQueue.front());
+        m_expiryQueue.pop();
+        auto record_it = m_waitingRecords.find(recordName);
+        // skip records released (and possibly re-queued) since
+        if (record_it == m_waitingRecords.end() || record_it->second.arrival != arrival) continue;
 
+        auto &waiting = record_it->second;
+        NDN_LOG_WARN("record " << recordName << " dropped after waiting for " << waiting.waitingFor);
+        auto [begin, end] = m_targetForWaitingRecords.equal_range(waiting.waitingFor);
+        for (auto it = begin; it != end; it++) {
+            if (it->second == recordName) {
+                m_targetForWaitingRecords.erase(it);
+                break;
+            }
+        }
+        if (waiting.record) {
+            m_memoryUsage -= waiting.size;
+        } else {
+            backend.deleteMetaData(getSpillKey(recordName));
+        }
+        m_waitingRecords.erase(record_it);
+    }
 }
 
-void DagReferenceChecker::addRecord(std::unique_ptr<Record> record, const Name &name, svs::SeqNo seqId) {
-    verifyPreviousRecord(std::move(record), name, seqId);
+void DagReferenceChecker::purgeSpilledRecords(Backend &backend) {
+    // not accepted, so their producers' versions stop before them and sync fetches them again
+    size_t purged = 0;
+    while (true) {
+        auto keys = backend.listMetaData(SPILL_KEY_PREFIX, "", SPILL_PURGE_BATCH);
+        if (keys.empty()) break;
+        for (const auto &key: keys) {
+            backend.deleteMetaData(key);
+        }
+        purged += keys.size();
+    }
+    if (purged > 0) {
+        NDN_LOG_INFO(purged << " waiting records of the previous run dropped from backend");
+    }
+}
+
+std::string DagReferenceChecker::getSpillKey(const Name &recordName) {
+    return SPILL_KEY_PREFIX + recordName.toUri(name::UriFormat::CANONICAL);
 }
 
 } //namespace mnemosyne
@@ -7,30 +7,93 @@
 
 #include "mnemosyne/backend.hpp"
 #include "mnemosyne/record.hpp"
+#include "dag-sync/recent-record-set.h"
 
 #include <ndn-svs/svsync.hpp>
+#include <chrono>
+#include <queue>
 
 namespace mnemosyne {
 
 /**
  * Check record references and cache unchecked records.
+ * Waiting records beyond the memory limit are kept in the backend metadata, and are dropped after the timeout.
+ * Those left in the backend by a previous run are dropped on construction, as the records are fetched again.
  */
 class DagReferenceChecker {
   public:
     DagReferenceChecker(std::weak_ptr<Backend> backend,
-                        std::function<void(std::unique_ptr<Record>, const Name &, svs::SeqNo)> readyRecordCallback);
+                        std::function<void(std::unique_ptr<Record>, const Name &, svs::SeqNo)> readyRecordCallback,
+                        size_t memoryLimit, std::chrono::seconds waitingTimeout, size_t recentRecordCacheSize);
 
     //TODO add mechanism to check for dangling record (mostly by duplicate name+seqId)
     void addRecord(std::unique_ptr<Record> record, const Name &name, svs::SeqNo seqId);
 
+    /**
+     * Remember an accepted record so that references to it are satisfied without reading the backend.
+     */
+    void addAcceptedRecord(const Name &recordFullName);
+
+    /**
+     * Treat the records up to @p versions as available, for a logger that started from a checkpoint.
+     */
+    void setCheckpoint(svs::VersionVector versions);
+
+    /**
+     * Call @p callback with the name of a preceding record not available yet, when a record first waits for it.
+     */
+    void setMissingRecordCallback(std::function<void(const Name &)> callback);
+
+    /**
+     * Drop the records that waited longer than the timeout. Also done whenever a record is added.
+     */
+    void evictExpired();
+
   private:
-    void verifyPreviousRecord(std::unique_ptr<Record> record, const Name &producer, svs::SeqNo seqId);
+    using RecordItem = std::tuple<std::unique_ptr<Record>, Name, svs::SeqNo>;
+
+    struct WaitingRecord {
+        std::unique_ptr<Record> record; // nullptr if spilled into the backend
+        Name producer;
+        svs::SeqNo seqId;
+        Name waitingFor;
+        std::chrono::steady_clock::time_point arrival;
+        size_t size;
+    };
+
+    /**
+     * @return the first preceding record not yet available, or nullopt if all are available
+     * @throw std::runtime_error if the record has a bad preceding record
+     */
+    std::optional<Name> findMissingPrecedingRecord(const Record &record, const Backend &backend) const;
+
+    void addWaitingRecord(RecordItem item, const Name &waitingFor, Backend &backend);
+
+    void releaseWaitingRecords(const Name &recordName, Backend &backend, std::queue<RecordItem> &worklist);
+
+    std::unique_ptr<Record> takeWaitingRecord(const Name &recordName, WaitingRecord &waiting, Backend &backend);
+
+    void evictExpiredRecords(Backend &backend);
+
+    void purgeSpilledRecords(Backend &backend);
+
+    static std::string getSpillKey(const Name &recordName);
 
   private:
     std::weak_ptr<Backend> m_backend;
     std::function<void(std::unique_ptr<Record>, const Name &, svs::SeqNo)> m_readyRecordCallback;
-    std::unordered_map<Name, std::tuple<std::unique_ptr<Record>, Name, svs::SeqNo>> m_waitingRecords;
+    std::function<void(const Name &)> m_missingRecordCallback;
+    std::unordered_map<Name, WaitingRecord> m_waitingRecords;
     std::multimap<Name, Name> m_targetForWaitingRecords;
+    std::queue<std::pair<std::chrono::steady_clock::time_point, Name>> m_expiryQueue;
+    size_t m_memoryLimit;
+    size_t m_memoryUsage;
+    std::chrono::seconds m_waitingTimeout;
+    dag::RecentRecordSet m_recentRecords;
+    svs::VersionVector m_checkpoint;
+
+    static const std::string SPILL_KEY_PREFIX;
+    static const uint32_t SPILL_PURGE_BATCH = 256;
 };
 
 } // namespace mnemosyne
@@ -0,0 +1,64 @@
+#include "hinted-fetch-cache.h"
+
+namespace mnemosyne::dag {
+
+HintedFetchCache::HintedFetchCache(size_t capacity, Clock::duration missingLifetime) :
+        m_capacity(capacity),
+        m_missingLifetime(missingLifetime) {
+}
+
+std::shared_ptr<const ndn::Data> HintedFetchCache::findServed(const ndn::Name &recordName) {
+    auto it = m_servedIndex.find(recordName);
+    if (it == m_servedIndex.end()) return nullptr;
+    m_served.splice(m_served.begin(), m_served, it->second);
+    return it->second->second;
+}
+
+void HintedFetchCache::insertServed(const ndn::Name &recordName, std::shared_ptr<const ndn::Data> data) {
+    if (m_capacity == 0) return;
+    auto it = m_servedIndex.find(recordName);
+    if (it != m_servedIndex.end()) {
+        it->second->second = std::move(data);
+        m_served.splice(m_served.begin(), m_served, it->second);
+        return;
+    }
+    if (m_served.size() >= m_capacity) {
+        m_servedIndex.erase(m_served.back().first);
+        m_served.pop_back();
+    }
+    m_served.emplace_front(recordName, std::move(data));
+    m_servedIndex.emplace(recordName, m_served.begin());
+}
+
+bool HintedFetchCache::isMissing(const ndn::Name &recordName, Clock::time_point now) {
+    pruneMissing(now);
+    return m_missing.count(recordName) != 0;
+}
+
+void HintedFetchCache::insertMissing(const ndn::Name &recordName, Clock::time_point now) {
+    if (m_capacity == 0) return;
+    pruneMissing(now);
+    while (m_missing.size() >= m_capacity && !m_missingOrder.empty()) {
+        auto &[name, time] = m_missingOrder.front();
+        auto it = m_missing.find(name);
+        if (it != m_missing.end() && it->second == time) m_missing.erase(it);
+        m_missingOrder.pop_front();
+    }
+    m_missing[recordName] = now;
+    m_missingOrder.emplace_back(recordName, now);
+}
+
+void HintedFetchCache::eraseMissing(const ndn::Name &recordName) {
+    m_missing.erase(recordName);
+}
+
+void HintedFetchCache::pruneMissing(Clock::time_point now) {
+    while (!m_missingOrder.empty() && now - m_missingOrder.front().second >= m_missingLifetime) {
+        auto &[name, time] = m_missingOrder.front();
+        auto it = m_missing.find(name);
+        if (it != m_missing.end() && it->second == time) m_missing.erase(it);
+        m_missingOrder.pop_front();
+    }
+}
+
+} // namespace mnemosyne::dag
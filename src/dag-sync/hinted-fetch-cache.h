@@ -0,0 +1,58 @@
+#ifndef MNEMOSYNE_HINTED_FETCH_CACHE_H
+#define MNEMOSYNE_HINTED_FETCH_CACHE_H
+
+#include <ndn-cxx/data.hpp>
+#include <ndn-cxx/name.hpp>
+#include <chrono>
+#include <deque>
+#include <list>
+#include <memory>
+#include <unordered_map>
+
+namespace mnemosyne::dag {
+
+/**
+ * Answers to hinted record Interests, keyed by record name without the implicit digest.
+ * Recently served records are kept in a LRU of bounded size. Records confirmed missing are remembered for a
+ * short lifetime, so that repeated Interests for them during a hint storm do not reach the backend.
+ */
+class HintedFetchCache {
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    HintedFetchCache(size_t capacity, Clock::duration missingLifetime);
+
+    /**
+     * @return the served record named @p recordName, nullptr if not cached
+     */
+    std::shared_ptr<const ndn::Data> findServed(const ndn::Name &recordName);
+
+    void insertServed(const ndn::Name &recordName, std::shared_ptr<const ndn::Data> data);
+
+    bool isMissing(const ndn::Name &recordName, Clock::time_point now = Clock::now());
+
+    void insertMissing(const ndn::Name &recordName, Clock::time_point now = Clock::now());
+
+    /**
+     * Forget that @p recordName is missing, once it is stored.
+     */
+    void eraseMissing(const ndn::Name &recordName);
+
+  private:
+    void pruneMissing(Clock::time_point now);
+
+  private:
+    size_t m_capacity;
+    Clock::duration m_missingLifetime;
+
+    std::list<std::pair<ndn::Name, std::shared_ptr<const ndn::Data>>> m_served;
+    std::unordered_map<ndn::Name, decltype(m_served)::iterator> m_servedIndex;
+
+    std::unordered_map<ndn::Name, Clock::time_point> m_missing;
+    // insertion order, for expiry; entries may be stale after eraseMissing or re-insertion
+    std::deque<std::pair<ndn::Name, Clock::time_point>> m_missingOrder;
+};
+
+} // namespace mnemosyne::dag
+
+#endif //MNEMOSYNE_HINTED_FETCH_CACHE_H
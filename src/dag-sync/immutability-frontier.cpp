@@ -0,0 +1,62 @@
+#include "immutability-frontier.h"
+
+#include <set>
+
+namespace mnemosyne::dag {
+
+ImmutabilityFrontier::ImmutabilityFrontier(uint32_t maxReference) :
+        m_maxReference(maxReference) {
+}
+
+void ImmutabilityFrontier::recordUpdate(const Record &record) {
+    if (m_maxReference == 0) return;
+    auto producer = Record::getProducerPrefix(record.getEncodedData()->getName());
+    if (m_counters.count(producer) == 0) {
+        m_counters.emplace(producer, std::make_unique<ReplicationCounter>(producer, m_maxReference));
+        m_interested[producer].insert(producer);
+    }
+
+    std::set<Name> pointedProducers;
+    for (const auto &pointer: record.getPointersFromHeader()) {
+        pointedProducers.insert(Record::getProducerPrefix(pointer));
+    }
+    std::set<Name> owners;
+    for (const auto &pointedProducer: pointedProducers) {
+        auto it = m_interested.find(pointedProducer);
+        if (it != m_interested.end()) {
+            owners.insert(it->second.begin(), it->second.end());
+        }
+    }
+
+    for (const auto &owner: owners) {
+        if (owner == producer) continue;
+        auto &counter = *m_counters.at(owner);
+        counter.recordUpdate(record);
+        if (counter.hasReferencePoints(producer)) {
+            m_interested[producer].insert(owner);
+        }
+        // drop interests whose reference points have been pruned
+        for (const auto &pointedProducer: pointedProducers) {
+            if (pointedProducer == owner || counter.hasReferencePoints(pointedProducer)) continue;
+            auto it = m_interested.find(pointedProducer);
+            if (it == m_interested.end()) continue;
+            it->second.erase(owner);
+            if (it->second.empty()) {
+                m_interested.erase(it);
+            }
+        }
+    }
+}
+
+uint64_t ImmutabilityFrontier::getImmutableSeqNo(const Name &producer) const {
+    auto it = m_counters.find(producer);
+    if (it == m_counters.end()) return 0;
+    return it->second->getMaxReferenceSeqNo();
+}
+
+bool ImmutabilityFrontier::isImmutable(const Name &recordName) const {
+    auto seqId = Record::getRecordSeqId(recordName);
+    return seqId > 0 && seqId <= getImmutableSeqNo(Record::getProducerPrefix(recordName));
+}
+
+} // namespace mnemosyne::dag
@@ -0,0 +1,44 @@
+#ifndef MNEMOSYNE_IMMUTABILITY_FRONTIER_H
+#define MNEMOSYNE_IMMUTABILITY_FRONTIER_H
+
+#include "replication-counter.h"
+#include "mnemosyne/record.hpp"
+#include <ndn-cxx/name.hpp>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace mnemosyne::dag {
+
+/**
+ * Track, for every producer in the DAG, the highest sequence number of its chain replicated at maxReference
+ * locations, with a ReplicationCounter per producer.
+ * A record only updates the counters of chains that its preceding records carry references to, found through a
+ * reverse index from producer to interested counters that is pruned lazily as reference points are dropped.
+ */
+class ImmutabilityFrontier {
+  public:
+    explicit ImmutabilityFrontier(uint32_t maxReference);
+
+    /**
+     * Add a record accepted into the ledger. Its preceding records must have been added before.
+     */
+    void recordUpdate(const Record &record);
+
+    /**
+     * @return the highest immutable sequence number of @p producer, 0 if none or unknown
+     */
+    uint64_t getImmutableSeqNo(const ndn::Name &producer) const;
+
+    bool isImmutable(const ndn::Name &recordName) const;
+
+  private:
+    uint32_t m_maxReference;
+    std::unordered_map<ndn::Name, std::unique_ptr<ReplicationCounter>> m_counters;
+    // producer -> owners of the counters that may follow references through its records
+    std::unordered_map<ndn::Name, std::unordered_set<ndn::Name>> m_interested;
+};
+
+} // namespace mnemosyne::dag
+
+#endif //MNEMOSYNE_IMMUTABILITY_FRONTIER_H
@@ -0,0 +1,29 @@
+#include "immutable-waiters.h"
+
+namespace mnemosyne::dag {
+
+ImmutableWaiters::ImmutableWaiters(uint32_t maxReference) :
+        m_maxReference(maxReference) {
+}
+
+bool ImmutableWaiters::await(uint64_t seqId, uint64_t immutableSeqNo, Callback callback) {
+    if (m_maxReference == 0) return false;
+    if (immutableSeqNo > 0 && seqId <= immutableSeqNo) {
+        callback(immutableSeqNo);
+        return true;
+    }
+    m_waiters.push({seqId, std::move(callback)});
+    return true;
+}
+
+void ImmutableWaiters::notify(uint64_t immutableSeqNo) {
+    if (immutableSeqNo == 0) return;
+    while (!m_waiters.empty() && m_waiters.top().seqId <= immutableSeqNo) {
+        // popped first, so that a callback awaiting again does not see itself
+        auto callback = m_waiters.top().callback;
+        m_waiters.pop();
+        callback(immutableSeqNo);
+    }
+}
+
+} // namespace mnemosyne::dag
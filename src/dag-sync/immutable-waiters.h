@@ -0,0 +1,56 @@
+#ifndef MNEMOSYNE_IMMUTABLE_WAITERS_H
+#define MNEMOSYNE_IMMUTABLE_WAITERS_H
+
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <vector>
+
+namespace mnemosyne::dag {
+
+/**
+ * The callbacks waiting for records of this logger to become immutable, called in sequence number order as the
+ * highest immutable sequence number of this logger grows.
+ */
+class ImmutableWaiters {
+  public:
+    using Callback = std::function<void(uint64_t immutableSeqNo)>;
+
+    /**
+     * @p maxReference, the replication count of an immutable record; immutability is not tracked if 0
+     */
+    explicit ImmutableWaiters(uint32_t maxReference);
+
+    /**
+     * Call @p callback once, when record @p seqId is immutable; at once if @p immutableSeqNo, the current highest
+     * immutable sequence number, already covers it.
+     * @return false, and @p callback is never called, if immutability is not tracked
+     */
+    bool await(uint64_t seqId, uint64_t immutableSeqNo, Callback callback);
+
+    /**
+     * Call the callbacks of the records up to @p immutableSeqNo, the new highest immutable sequence number.
+     */
+    void notify(uint64_t immutableSeqNo);
+
+    size_t size() const {
+        return m_waiters.size();
+    }
+
+  private:
+    struct Waiter {
+        uint64_t seqId;
+        Callback callback;
+
+        bool operator>(const Waiter &other) const {
+            return seqId > other.seqId;
+        }
+    };
+
+    uint32_t m_maxReference;
+    std::priority_queue<Waiter, std::vector<Waiter>, std::greater<>> m_waiters;
+};
+
+} // namespace mnemosyne::dag
+
+#endif //MNEMOSYNE_IMMUTABLE_WAITERS_H
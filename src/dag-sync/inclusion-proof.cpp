@@ -0,0 +1,55 @@
+#include "inclusion-proof.h"
+
+#include "mnemosyne/record.hpp"
+#include <queue>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace mnemosyne::dag {
+
+std::optional<std::vector<std::shared_ptr<const Data>>>
+buildInclusionProof(const Backend &backend, const Name &recordFullName, size_t producerNum) {
+    if (!backend.getRecord(recordFullName)) return std::nullopt;
+    auto recordProducer = Record::getProducerPrefix(recordFullName);
+
+    // breadth-first over referencing records, remembering the record each one was reached from
+    std::unordered_map<Name, Name> reachedFrom{{recordFullName, Name()}};
+    std::queue<Name> frontier;
+    frontier.push(recordFullName);
+    std::unordered_set<Name> coveredProducers;
+    std::vector<Name> proof{recordFullName};
+    std::unordered_set<Name> inProof{recordFullName};
+    while (!frontier.empty() && coveredProducers.size() < producerNum) {
+        auto current = std::move(frontier.front());
+        frontier.pop();
+        for (auto &next: backend.getReferencingRecords(current)) {
+            if (!reachedFrom.emplace(next, current).second) continue;
+            auto producer = Record::getProducerPrefix(next);
+            if (producer != recordProducer && coveredProducers.insert(producer).second) {
+                // add the path from the proof so far to this record
+                std::vector<Name> path;
+                for (auto i = next; !inProof.count(i); i = reachedFrom.at(i)) {
+                    path.push_back(i);
+                }
+                for (auto i = path.rbegin(); i != path.rend(); i++) {
+                    inProof.insert(*i);
+                    proof.push_back(std::move(*i));
+                }
+                if (coveredProducers.size() >= producerNum) break;
+            }
+            frontier.push(std::move(next));
+        }
+    }
+    if (coveredProducers.size() < producerNum) return std::nullopt;
+
+    std::vector<std::shared_ptr<const Data>> ans;
+    ans.reserve(proof.size());
+    for (const auto &name: proof) {
+        auto data = backend.getRecord(name);
+        if (!data) return std::nullopt;
+        ans.push_back(std::move(data));
+    }
+    return ans;
+}
+
+} // namespace mnemosyne::dag
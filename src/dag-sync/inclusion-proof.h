@@ -0,0 +1,24 @@
+#ifndef MNEMOSYNE_INCLUSION_PROOF_H
+#define MNEMOSYNE_INCLUSION_PROOF_H
+
+#include "mnemosyne/backend.hpp"
+#include <ndn-cxx/data.hpp>
+#include <ndn-cxx/name.hpp>
+#include <optional>
+#include <vector>
+
+namespace mnemosyne::dag {
+
+/**
+ * Build a proof that a record is included in the DAG: the shortest referencing paths, over the backend's reverse
+ * reference index, from the record to records of @p producerNum producers other than its own.
+ * The cost is bounded by the records within the breadth-first radius of the proof, not by the size of storage.
+ * @return the record first, then each referencing record after the record it points to on its path;
+ *         nullopt if the record is not stored or fewer producers reference it
+ */
+std::optional<std::vector<std::shared_ptr<const ndn::Data>>>
+buildInclusionProof(const Backend &backend, const ndn::Name &recordFullName, size_t producerNum);
+
+} // namespace mnemosyne::dag
+
+#endif //MNEMOSYNE_INCLUSION_PROOF_H
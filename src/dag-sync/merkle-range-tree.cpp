@@ -0,0 +1,57 @@
+#include "merkle-range-tree.h"
+
+#include <ndn-cxx/util/sha256.hpp>
+#include <algorithm>
+
+namespace mnemosyne::dag {
+
+const MerkleRangeTree::Digest MerkleRangeTree::EMPTY{};
+
+void MerkleRangeTree::set(uint64_t seqId, const Digest &leaf) {
+    if (m_levels.empty()) m_levels.emplace_back();
+    if (m_levels[0].size() <= seqId) m_levels[0].resize(seqId + 1, EMPTY);
+    m_levels[0][seqId] = leaf;
+
+    uint64_t index = seqId;
+    for (size_t level = 1; m_levels[level - 1].size() > 1; level++) {
+        if (m_levels.size() == level) m_levels.emplace_back();
+        auto &nodes = m_levels[level];
+        auto &children = m_levels[level - 1];
+        auto oldSize = nodes.size();
+        nodes.resize((children.size() + 1) / 2, EMPTY);
+        index /= 2;
+        // new nodes may have a child that had no parent before, other than on the updated path
+        for (auto i = std::min<uint64_t>(oldSize, index); i < nodes.size(); i++) {
+            if (i >= oldSize || i == index) {
+                nodes[i] = combine(children[2 * i], 2 * i + 1 < children.size() ? children[2 * i + 1] : EMPTY);
+            }
+        }
+    }
+}
+
+MerkleRangeTree::Digest MerkleRangeTree::get(size_t level, uint64_t index) const {
+    if (m_levels.empty()) return EMPTY;
+    if (level < m_levels.size()) {
+        return index < m_levels[level].size() ? m_levels[level][index] : EMPTY;
+    }
+    return index == 0 ? lift(m_levels.back()[0], getHeight(), level) : EMPTY;
+}
+
+MerkleRangeTree::Digest MerkleRangeTree::combine(const Digest &left, const Digest &right) {
+    if (left == EMPTY && right == EMPTY) return EMPTY;
+    ndn::util::Sha256 sha;
+    sha << left << right;
+    auto buffer = sha.computeDigest();
+    Digest digest;
+    std::copy_n(buffer->begin(), digest.size(), digest.begin());
+    return digest;
+}
+
+MerkleRangeTree::Digest MerkleRangeTree::lift(Digest digest, size_t fromLevel, size_t toLevel) {
+    for (auto level = fromLevel; level < toLevel; level++) {
+        digest = combine(digest, EMPTY);
+    }
+    return digest;
+}
+
+} // namespace mnemosyne::dag
@@ -0,0 +1,48 @@
+#ifndef MNEMOSYNE_MERKLE_RANGE_TREE_H
+#define MNEMOSYNE_MERKLE_RANGE_TREE_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace mnemosyne::dag {
+
+/**
+ * A binary Merkle tree over the record digests of one producer's chain, indexed by sequence number.
+ * Node (level, index) summarizes the sequence numbers [index * 2^level, (index + 1) * 2^level).
+ * A range without any record hashes to EMPTY at every level, so trees of different sizes can be compared
+ * node by node. Setting a leaf costs O(log n).
+ */
+class MerkleRangeTree {
+  public:
+    using Digest = std::array<uint8_t, 32>;
+
+    static const Digest EMPTY;
+
+    void set(uint64_t seqId, const Digest &leaf);
+
+    Digest get(size_t level, uint64_t index) const;
+
+    /**
+     * @return the lowest level whose node 0 covers all the leaves
+     */
+    size_t getHeight() const {
+        return m_levels.empty() ? 0 : m_levels.size() - 1;
+    }
+
+    static Digest combine(const Digest &left, const Digest &right);
+
+    /**
+     * @return the hash at @p toLevel of node 0 whose hash at @p fromLevel is @p digest, with only empty ranges after it
+     */
+    static Digest lift(Digest digest, size_t fromLevel, size_t toLevel);
+
+  private:
+    // m_levels[l] has ceil(m_levels[l - 1].size() / 2) nodes; the last level has one
+    std::vector<std::vector<Digest>> m_levels;
+};
+
+} // namespace mnemosyne::dag
+
+#endif //MNEMOSYNE_MERKLE_RANGE_TREE_H
@@ -1,8 +1,19 @@
 #include "mnemosyne/mnemosyne-dag-logger.hpp"
 
+#include "dag-sync/anti-entropy.h"
+#include "dag-sync/checkpoint.h"
 #include "dag-sync/dag-reference-checker.h"
+#include "dag-sync/immutability-frontier.h"
+#include "dag-sync/immutable-waiters.h"
+#include "dag-sync/inclusion-proof.h"
+#include "dag-sync/pending-records.h"
 #include "dag-sync/replication-counter.h"
 #include "dag-sync/record-sync.h"
+#include "dag-sync/replication-aware-tip-selection.h"
+#include "dag-sync/submission-queue.h"
+#include "dag-sync/sync-groups.h"
+#include "dag-sync/tailing-record-set.h"
+#include "dag-sync/width-controller.h"
 #include "util.hpp"
 
 #include <ndn-cxx/encoding/block-helpers.hpp>
@@ -11,6 +22,7 @@
 #include <ndn-cxx/security/verification-helpers.hpp>
 #include <ndn-cxx/util/logger.hpp>
 #include <ndn-cxx/util/logging.hpp>
+#include <boost/asio/post.hpp>
 #include <algorithm>
 #include <random>
 #include <sstream>
@@ -21,6 +33,8 @@ using namespace ndn;
 namespace mnemosyne {
 
 const std::string MnemosyneDagLogger::SEQ_NO_BACKUP_KEY = "SeqNoBackup";
+const std::string MnemosyneDagLogger::AGREED_CHECKPOINT_KEY = "AgreedCheckpoint";
+const std::string MnemosyneDagLogger::BOOTSTRAP_CHECKPOINT_KEY = "BootstrapCheckpoint";
 
 MnemosyneDagLogger::MnemosyneDagLogger(const LoggerConfig &config,
                                        security::KeyChain &keychain,
@@ -30,30 +44,109 @@ MnemosyneDagLogger::MnemosyneDagLogger(const LoggerConfig &config,
         : m_config(config),
           m_backend(std::make_shared<Backend>(config.databaseType, config.databasePath, m_config.seqNoBackupFreq)),
           m_dagReferenceChecker(std::make_unique<DagReferenceChecker>(m_backend,
-                                                                      std::bind(&MnemosyneDagLogger::addReceivedRecord,
-                                                                                this, _1, _2, _3))),
+                                                                      [this](auto record, const auto &producer,
+                                                                             auto seqId) {
+                                                                          addReceivedRecord(*record, producer, seqId);
+                                                                      },
+                                                                      config.waitingRecordMemoryLimit,
+                                                                      config.waitingRecordTimeout,
+                                                                      config.recentRecordCacheSize)),
           m_replicationCounter(
                   std::make_unique<dag::ReplicationCounter>(config.peerPrefix, config.maxCountedReplication)),
-          m_dagSync(make_unique<dag::RecordSync>(config.syncPrefix, config.peerPrefix, config.hintPrefix, network,
+          m_immutabilityFrontier(std::make_unique<dag::ImmutabilityFrontier>(config.maxCountedReplication)),
+          m_immutableWaiters(std::make_shared<dag::ImmutableWaiters>(config.maxCountedReplication)),
+          m_syncGroups(std::make_unique<dag::SyncGroups>(config.syncPrefix, config.peerPrefix,
+                                                         config.syncGroupCount)),
+          m_dagSync(make_unique<dag::RecordSync>(m_syncGroups->getGroupPrefix(m_syncGroups->getOwnGroup()),
+                                                 config.peerPrefix,
+                                                 config.hintPrefix, network,
                                                  [&](const auto &i) { onUpdate(i); },
                                                  m_backend,
                                                  getSecurityOption(keychain, recordValidator, config.peerPrefix))),
-          m_randomEngine(std::random_device()()), m_KnownSelfSeqId(0), m_onRecordCallback(onRecordCallback) {
+          m_lastRecordInChains(getTipSelectionPolicy(config)),
+          m_widthController(std::make_unique<dag::WidthController>(config)),
+          m_randomEngine(std::random_device()()), m_KnownSelfSeqId(0), m_onRecordCallback(onRecordCallback),
+          m_keychain(keychain), m_face(network), m_recordValidator(recordValidator),
+          m_scheduler(network.getIoService()), m_recordsSinceCheckpoint(0), m_bootstrapping(false),
+          m_pendingRecords(std::make_unique<dag::PendingRecords>(config.pendingRecordTimeout)),
+          m_submissions(std::make_shared<dag::SubmissionQueue<Submission>>(config.submissionQueueCapacity)),
+          m_submissionDrainPosted(false) {
     NDN_LOG_DEBUG("Mnemosyne Initialization Start");
 
     if (config.precedingRecordNum <= 1) {
         NDN_THROW(std::runtime_error("Bad config"));
     }
 
+    if (config.syncGroupCount == 0) {
+        NDN_THROW(std::runtime_error("Bad config"));
+    }
+
+    // checkpoints are agreed once immutable, which is not tracked without replication counting
+    if ((config.checkpointRecordInterval > 0 || config.checkpointPeriod.count() > 0 ||
+         config.bootstrapFromCheckpoint) && config.maxCountedReplication == 0) {
+        NDN_THROW(std::runtime_error("Bad config"));
+    }
+    m_groupListeners.resize(config.syncGroupCount);
+    for (uint32_t group = 0; group < config.syncGroupCount; group++) {
+        if (group == m_syncGroups->getOwnGroup()) continue;
+        // a listener never publishes, so it does not add this logger to the group's version vector
+        m_groupListeners[group] = make_unique<dag::RecordSync>(m_syncGroups->getGroupPrefix(group), config.peerPrefix,
+                                                               config.hintPrefix, network,
+                                                               [this](const auto &i) { onUpdate(i); },
+                                                               m_backend,
+                                                               getSecurityOption(keychain, recordValidator,
+                                                                                 config.peerPrefix),
+                                                               false);
+    }
+    if (config.syncGroupCount > 1) {
+        // a record may reference one of another group before that group's sync update arrives
+        m_dagReferenceChecker->setMissingRecordCallback([this](const Name &recordName) {
+            auto producer = Record::getProducerPrefix(recordName);
+            if (m_syncGroups->isFetchedOnReference(recordName, m_dagCollectedVersions.get(producer))) {
+                fetchRecord(producer, Record::getRecordSeqId(recordName));
+            }
+        });
+    }
+
+    if (m_config.antiEntropyPeriod.count() > 0) {
+        m_antiEntropy = std::make_unique<dag::AntiEntropy>(m_face, m_keychain, m_recordValidator,
+                                                           m_config.hintPrefix, m_config.peerPrefix,
+                                                           [this](const Name &producer, uint64_t seqId) {
+                                                               // earlier records are stored, being fetched, or
+                                                               // before the bootstrap checkpoint
+                                                               if (seqId > m_dagCollectedVersions.get(producer)) {
+                                                                   fetchRecord(producer, seqId);
+                                                               }
+                                                           });
+    }
+
+    bool isNewLogger = !m_backend->getMetaData(SEQ_NO_BACKUP_KEY);
     restoreRecordSyncVersionVector();
 
-    if (m_lastRecordInChains.empty()) {
+    if (m_lastRecordInChains->size() == 0) {
         addPublicGenesisRecord();
     }
 
-    if (!m_lastRecordInChains.count(m_config.peerPrefix)) {
-        m_lastRecordInChains[m_config.peerPrefix] = std::make_pair(Record::getGenesisRecordFullName(
-                Record::getRecordName(m_config.peerPrefix, 0)), m_config.maxSelfReRefCount);
+    if (!m_lastRecordInChains->contains(m_config.peerPrefix)) {
+        m_lastRecordInChains->update(m_config.peerPrefix, Record::getGenesisRecordFullName(
+                Record::getRecordName(m_config.peerPrefix, 0)), m_widthController->getSelfReRefCount());
+    }
+
+    if (m_config.checkpointRecordInterval > 0 || m_config.checkpointPeriod.count() > 0) {
+        m_checkpointFilterHandle = m_face.setInterestFilter(Name(m_config.hintPrefix).append("CHECKPOINT"),
+                                                            [this](auto &&, const auto &interest) {
+                                                                onCheckpointInterest(interest);
+                                                            });
+    }
+    if (m_config.checkpointPeriod.count() > 0) {
+        scheduleCheckpoint();
+    }
+    if (m_antiEntropy) {
+        scheduleAntiEntropy();
+    }
+    scheduleWaitingRecordEviction();
+    if (m_config.bootstrapFromCheckpoint && isNewLogger) {
+        bootstrapFromCheckpoint(m_config.hintedFetchRetries);
     }
 
     NDN_LOG_DEBUG("Mnemosyne Dag Logger Initialization Succeed");
@@ -73,12 +166,39 @@ void MnemosyneDagLogger::restoreRecordSyncVersionVector() {
         }
     }
 
+    // records up to the checkpoint this logger started from are not stored
+    svs::VersionVector checkpointVersions;
+    auto checkpointPage = m_backend->getMetaData(BOOTSTRAP_CHECKPOINT_KEY);
+    if (checkpointPage) {
+        try {
+            ndn::Block block(make_span(reinterpret_cast<const uint8_t *>(checkpointPage->data()),
+                                       checkpointPage->size()));
+            Record record(std::make_shared<Data>(block));
+            dag::Checkpoint checkpoint(record.getContentData().value());
+            checkpointVersions = checkpoint.getVersions();
+            m_dagReferenceChecker->setCheckpoint(checkpointVersions);
+            setAntiEntropyFloors(checkpointVersions);
+            for (const auto &tip: checkpoint.getTips()) {
+                m_lastRecordInChains->update(Record::getProducerPrefix(tip), tip,
+                                             m_widthController->getSelfReRefCount());
+            }
+            NDN_LOG_DEBUG("Bootstrap checkpoint recovery success");
+        } catch (const std::exception &e) {
+            NDN_LOG_DEBUG("Bootstrap checkpoint recovery failed with exception: " << e.what());
+            exit(1);
+        }
+    }
+    auto agreedCheckpoint = m_backend->getMetaData(AGREED_CHECKPOINT_KEY);
+    if (agreedCheckpoint) {
+        m_agreedCheckpoint = Name(*agreedCheckpoint);
+    }
+
     if (m_dagCollectedVersions.get(m_config.peerPrefix) == 0)
         m_dagCollectedVersions.set(m_config.peerPrefix, 0);
     for (const auto &[producer, s]: m_dagCollectedVersions) {
         auto seq = s;
         auto listed = m_backend->listRecord(Record::getRecordName(producer, seq), 1);
-        if (producer != m_config.peerPrefix && listed.empty()) {
+        if (producer != m_config.peerPrefix && listed.empty() && seq > checkpointVersions.get(producer)) {
             NDN_LOG_FATAL("Failed to restore sequenced record");
             exit(1);
         }
@@ -87,15 +207,21 @@ void MnemosyneDagLogger::restoreRecordSyncVersionVector() {
             if (l.empty()) {
                 break;
             } else {
-                if (producer != m_config.peerPrefix && m_onRecordCallback) {
+                // including this logger's own records, whose events it must not insert again
+                if (m_onRecordCallback) {
                     m_onRecordCallback(m_backend->getRecord(*l.begin()));
                 }
                 seq++;
-                m_lastRecordInChains[producer] = std::make_pair(*l.begin(), m_config.maxSelfReRefCount);
+                m_lastRecordInChains->update(producer, *l.begin(), m_widthController->getSelfReRefCount());
             }
         }
-        m_dagSync->getCore().updateSeqNo(seq, producer);
+        getGroupSync(producer).getCore().updateSeqNo(seq, producer);
         m_dagCollectedVersions.set(producer, seq);
+        if (m_antiEntropy) {
+            for (const auto &recordName: m_backend->listRecord(Name(producer).append("RECORD"), 0)) {
+                m_antiEntropy->addRecord(recordName);
+            }
+        }
 
         if (producer == m_config.peerPrefix) {
             m_KnownSelfSeqId = seq;
@@ -110,11 +236,11 @@ void MnemosyneDagLogger::addPublicGenesisRecord() {
     //****STEP 2****
     // Make the public genesis data
     int i = 0;
-    while (m_lastRecordInChains.size() < m_config.precedingRecordNum - 1) {
+    while (m_lastRecordInChains->size() < m_widthController->getMaxPrecedingRecordNum() - 1) {
         Name tempProducer = Name().appendNumber(i++);
-        if (m_lastRecordInChains.count(tempProducer)) continue;
-        m_lastRecordInChains.emplace(tempProducer, std::make_pair(Record::getGenesisRecordFullName(Record::getRecordName(
-                tempProducer, 0)), 1));
+        if (m_lastRecordInChains->contains(tempProducer)) continue;
+        m_lastRecordInChains->update(tempProducer, Record::getGenesisRecordFullName(Record::getRecordName(
+                tempProducer, 0)), 1);
     }
     NDN_LOG_DEBUG(" - " << i << " genesis records have been added to the Mnemosyne");
 }
@@ -124,64 +250,128 @@ MnemosyneDagLogger::~MnemosyneDagLogger() = default;
 ReturnCode MnemosyneDagLogger::createRecord(Record &record) {
     NDN_LOG_DEBUG("[MnemosyneDagLogger::createRecord] create record called");
 
-    if (Record::getRecordSeqId(m_lastRecordInChains.at(m_config.peerPrefix).first) < m_KnownSelfSeqId) {
+    auto ready = checkCreationReady();
+    if (!ready.success()) return ready;
+    auto seqId = addSelfRecord(record, 0);
+    m_dagSync->announceData(*record.getEncodedData(), m_config.peerPrefix, seqId);
+    return ReturnCode::noError(record.getRecordFullName().toUri());
+}
+
+size_t MnemosyneDagLogger::getPendingRecordCount() const {
+    return m_pendingRecords->size();
+}
+
+void MnemosyneDagLogger::createRecordsAsync(ndn::span<Record> records, BatchCallback callback) {
+    for (size_t i = 0; i < records.size(); i++) {
+        SubmitCallback onCreated;
+        if (callback) {
+            onCreated = [callback, i](ReturnCode result) { callback(i, std::move(result)); };
+        }
+        m_pendingRecords->push(std::move(records[i]), std::move(onCreated));
+    }
+    publishPendingRecords();
+}
+
+ReturnCode MnemosyneDagLogger::checkCreationReady() {
+    if (m_bootstrapping) {
+        return ReturnCode::timingError("Waiting for the bootstrap checkpoint");
+    }
+    if (Record::getRecordSeqId(m_lastRecordInChains->getRecord(m_config.peerPrefix)) < m_KnownSelfSeqId) {
         NDN_LOG_WARN("[MnemosyneDagLogger::createRecord] waiting for record discovery: " << m_KnownSelfSeqId);
         return ReturnCode::timingError("Waiting for self record recovery");
     }
-    if (m_lastRecordInChains.size() < m_config.precedingRecordNum) {
+    // without replication counting, progress is judged by the arrival rate only
+    m_widthController->adjust(m_config.maxCountedReplication == 0 ? 0 :
+                              m_KnownSelfSeqId - std::min(m_KnownSelfSeqId, getMaxReferenceSeqNo()));
+    if (m_lastRecordInChains->size() < m_widthController->getMinPrecedingRecordNum()) {
         NDN_LOG_WARN(
-                "[MnemosyneDagLogger::createRecord] Not Enough Tailing Record: " << m_lastRecordInChains.size() << " < "
-                                                                                 << m_config.precedingRecordNum);
+                "[MnemosyneDagLogger::createRecord] Not Enough Tailing Record: " << m_lastRecordInChains->size() << " < "
+                                                                                 << m_widthController->getMinPrecedingRecordNum());
         return ReturnCode::notEnoughTailingRecord();
     }
+    return ReturnCode::noError();
+}
 
+svs::SeqNo MnemosyneDagLogger::addSelfRecord(Record &record, svs::SeqNo seqId) {
     selectAndAddPrecedingRecords(record);
 
-    //send sync interest
-    auto seqId = m_dagSync->publishData(record, time::minutes(5), m_config.peerPrefix, tlv::Data);
+    seqId = m_dagSync->prepareData(record, time::minutes(5), m_config.peerPrefix, tlv::Data, seqId);
     NDN_LOG_DEBUG("[MnemosyneDagLogger::createRecord] Added a new record:" << record.getRecordFullName().toUri());
-    // add new record into the ledger
-    addReceivedRecord(std::make_unique<Record>(record), m_config.peerPrefix, seqId);
-    return ReturnCode::noError(record.getRecordFullName().toUri());
+    // add new record into the ledger, which persists it, before the caller sends the sync interest
+    addReceivedRecord(record, m_config.peerPrefix, seqId);
+    return seqId;
 }
 
-void MnemosyneDagLogger::selectAndAddPrecedingRecords(Record &record) {
-    record.addPointer(m_lastRecordInChains.at(m_config.peerPrefix).first);
-    m_lastRecordInChains.erase(m_config.peerPrefix);
-
-    // randomly shuffle the tailing record list
-    std::vector<uint32_t> refCountInLastRecord(m_config.maxSelfReRefCount + 1, 0);
-    std::vector<std::pair<Name, uint32_t>> candidateList;
-    for (const auto& i: m_lastRecordInChains) {
-        refCountInLastRecord.at(i.second.second) ++;
-        candidateList.push_back(i.second);
-    }
-    uint32_t neededCounts = m_config.maxSelfReRefCount + 1;
-    uint32_t candidates = 0;
-    while (candidates < m_config.precedingRecordNum - 1) {
-        assert(neededCounts > 0);
-        neededCounts --;
-        candidates += refCountInLastRecord.at(neededCounts);
-    }
-    candidateList.erase(std::remove_if(candidateList.begin(), candidateList.end(),
-                                       [neededCounts](const auto& i){return i.second < neededCounts; }),
-                        candidateList.end());
-    assert(candidateList.size() == candidates);
-
-    std::vector<std::pair<Name, uint32_t>> recordList;
-    std::sample(candidateList.begin(), candidateList.end(),
-                std::back_inserter(recordList), m_config.precedingRecordNum - 1, m_randomEngine);
-
-    for (const auto &[name, count]: recordList) {
-        record.addPointer(name);
-        auto it = m_lastRecordInChains.find(Record::getProducerPrefix(name));
-        assert(it != m_lastRecordInChains.end());
-        if (count == 1)
-            m_lastRecordInChains.erase(it);
-        else it->second.second -= 1;
-        if (record.getPointersFromHeader().size() >= m_config.precedingRecordNum)
-            break;
+void MnemosyneDagLogger::publishPendingRecords() {
+    m_pendingRecords->expire();
+    if (m_pendingRecords->empty()) return;
+    // also retried while no records arrive, as the width may shrink to the tails available
+    m_pendingRecordEvent = m_scheduler.schedule(time::seconds(1), [this] { publishPendingRecords(); });
+    if (!checkCreationReady().success()) return;
+
+    std::vector<std::shared_ptr<const Data>> published;
+    svs::SeqNo seqId = 0;
+    // each record created leaves the tails for the next one, its own among them
+    auto created = m_pendingRecords->create([&](Record &record) {
+        seqId = addSelfRecord(record, seqId == 0 ? 0 : seqId + 1);
+        published.push_back(record.getEncodedData());
+    }, [this] { return m_lastRecordInChains->size() >= m_widthController->getMinPrecedingRecordNum(); });
+    m_dagSync->announceData(published, m_config.peerPrefix, seqId);
+
+    for (auto &entry: created) {
+        if (entry.callback) {
+            entry.callback(ReturnCode::noError(entry.record.getRecordFullName().toUri()));
+        }
+    }
+}
+
+ReturnCode MnemosyneDagLogger::submitRecord(Record record, SubmitCallback callback) {
+    Submission submission{std::move(record), std::move(callback)};
+    if (!m_submissions->push(submission)) {
+        return ReturnCode::queueFull();
+    }
+    // one drain is posted for any number of submissions until it starts
+    if (!m_submissionDrainPosted.exchange(true)) {
+        postSubmissionDrain();
     }
+    return ReturnCode::noError();
+}
+
+std::future<ReturnCode> MnemosyneDagLogger::submitRecord(Record record) {
+    auto promise = std::make_shared<std::promise<ReturnCode>>();
+    auto result = submitRecord(std::move(record), [promise](ReturnCode ret) { promise->set_value(std::move(ret)); });
+    if (!result.success()) promise->set_value(result);
+    return promise->get_future();
+}
+
+void MnemosyneDagLogger::postSubmissionDrain() {
+    boost::asio::post(m_face.getIoService(), [this, submissions = std::weak_ptr(m_submissions)] {
+        if (submissions.expired()) return;
+        drainSubmissions();
+    });
+}
+
+void MnemosyneDagLogger::drainSubmissions() {
+    // cleared before popping, so that a submission the pops miss posts another drain
+    m_submissionDrainPosted = false;
+    size_t drained = 0;
+    for (; drained < SUBMISSION_BATCH_SIZE; drained++) {
+        auto submission = m_submissions->pop();
+        if (!submission) break;
+        m_pendingRecords->push(std::move(submission->record), std::move(submission->callback));
+    }
+    publishPendingRecords();
+    if (drained == SUBMISSION_BATCH_SIZE && !m_submissionDrainPosted.exchange(true)) {
+        postSubmissionDrain();
+    }
+}
+
+void MnemosyneDagLogger::selectAndAddPrecedingRecords(Record &record) {
+    record.addPointer(m_lastRecordInChains->getRecord(m_config.peerPrefix));
+    m_lastRecordInChains->erase(m_config.peerPrefix);
+    // a wider DAG than there are tails for falls back to the tails available
+    auto width = std::min(m_widthController->getPrecedingRecordNum(), m_lastRecordInChains->size() + 1);
+    m_lastRecordInChains->selectInto(record, width - 1, m_randomEngine);
 }
 
 std::list<uint64_t> MnemosyneDagLogger::getReplicationSeqId() const {
@@ -194,9 +384,51 @@ uint64_t MnemosyneDagLogger::getMaxReferenceSeqNo() const {
     return m_replicationCounter->getMaxReferenceSeqNo();
 }
 
+bool MnemosyneDagLogger::awaitImmutable(uint64_t seqId, ImmutableCallback callback) {
+    return m_immutableWaiters->await(seqId, m_replicationCounter->getMaxReferenceSeqNo(), std::move(callback));
+}
+
+std::future<uint64_t> MnemosyneDagLogger::awaitImmutable(uint64_t seqId) {
+    auto promise = std::make_shared<std::promise<uint64_t>>();
+    auto future = promise->get_future();
+    if (m_config.maxCountedReplication == 0) {
+        promise->set_exception(std::make_exception_ptr(
+                std::logic_error("Immutability is not tracked with maxCountedReplication 0")));
+        return future;
+    }
+    // a wait posted before the logger is destroyed leaves the future broken
+    boost::asio::post(m_face.getIoService(), [this, seqId, promise, waiters = std::weak_ptr(m_immutableWaiters)] {
+        if (waiters.expired()) return;
+        awaitImmutable(seqId, [promise](uint64_t immutableSeqNo) { promise->set_value(immutableSeqNo); });
+    });
+    return future;
+}
+
+uint64_t MnemosyneDagLogger::getImmutableSeqNo(const Name &producer) const {
+    return m_immutabilityFrontier->getImmutableSeqNo(producer);
+}
+
+bool MnemosyneDagLogger::isImmutable(const Name &recordName) const {
+    return m_immutabilityFrontier->isImmutable(recordName);
+}
+
+std::optional<std::vector<std::shared_ptr<const Data>>>
+MnemosyneDagLogger::getInclusionProof(const Name &recordFullName, size_t producerNum) const {
+    return dag::buildInclusionProof(*m_backend, recordFullName, producerNum);
+}
+
+void MnemosyneDagLogger::notifyImmutableWaiters() {
+    m_immutableWaiters->notify(m_replicationCounter->getMaxReferenceSeqNo());
+}
+
 void MnemosyneDagLogger::onUpdate(const std::vector<ndn::svs::MissingDataInfo> &info) {
+    if (m_bootstrapping) {
+        m_bootstrapUpdates.insert(m_bootstrapUpdates.end(), info.begin(), info.end());
+        return;
+    }
     for (const auto &stream: info) {
         NDN_LOG_DEBUG("Sync discovered Data " << stream.nodeId << " " << stream.low << " - " << stream.high);
+        if (m_onSyncUpdateCallback) m_onSyncUpdateCallback(stream.nodeId);
         if (stream.nodeId == m_config.peerPrefix) {
             m_KnownSelfSeqId = std::max(m_KnownSelfSeqId, stream.high);
         }
@@ -208,58 +440,320 @@ void MnemosyneDagLogger::onUpdate(const std::vector<ndn::svs::MissingDataInfo> &
         }
 
         for (svs::SeqNo i = lastNo; i <= stream.high; i++) {
-            NDN_LOG_DEBUG("Fetching item " << stream.nodeId << " " << i);
-            m_dagSync->fetchRecord(stream.nodeId, i, [nodeId = stream.nodeId, i, this](const Data &data) {
-                                       auto receivedData = std::make_shared<Data>(data);
-                                       try {
-                                           auto receivedRecord = make_unique<Record>(receivedData);
-                                           receivedRecord->checkPointerCount(m_config.precedingRecordNum);
-                                           m_dagReferenceChecker->addRecord(std::move(receivedRecord), nodeId, i);
-                                       } catch (const std::exception &e) {
-                                           NDN_LOG_ERROR("bad record received" << receivedData->getFullName() << ": " << e.what());
-                                       }
-                                   }, stream.nodeId == m_config.peerPrefix ? 0 : m_config.recordFetchRetries,
-                                   m_config.hintedFetchRetries,
-                                   [](const Data &data, const ndn::security::ValidationError &error) {
-                                       NDN_LOG_ERROR(
-                                               "Verification error on Received record " << data.getFullName() << ": "
-                                                                                        << error.getInfo());
-                                   }, [nodeId = stream.nodeId, i](auto &...) {
-                        NDN_LOG_ERROR("Fetch timeout on Received record " << nodeId << " - Sequence Id " << i);
-                    });
+            fetchRecord(stream.nodeId, i);
         }
     }
 }
 
-void MnemosyneDagLogger::addReceivedRecord(std::unique_ptr<Record> record, const Name &producer, svs::SeqNo seqId) {
-    NDN_LOG_DEBUG("Add record to ledger: " << record->getRecordFullName());
-    const shared_ptr<const Data> &recordData = record->getEncodedData();
+void MnemosyneDagLogger::fetchRecord(const Name &producer, svs::SeqNo seqId) {
+    NDN_LOG_DEBUG("Fetching item " << producer << " " << seqId);
+    m_dagSync->fetchRecord(producer, seqId, [producer, seqId, this](const Data &data) {
+                               // the same record may be fetched through more than one path. A producer's records
+                               // are accepted in order, as each points to the previous one, so one at or below the
+                               // collected version is in the ledger or covered by the bootstrap checkpoint
+                               if (seqId <= m_dagCollectedVersions.get(producer)) return;
+                               auto receivedData = std::make_shared<Data>(data);
+                               try {
+                                   auto receivedRecord = make_unique<Record>(receivedData);
+                                   receivedRecord->checkPointerCount(m_widthController->getMinPrecedingRecordNum(),
+                                                                     m_widthController->getMaxPrecedingRecordNum());
+                                   m_dagReferenceChecker->addRecord(std::move(receivedRecord), producer, seqId);
+                               } catch (const std::exception &e) {
+                                   NDN_LOG_ERROR("bad record received" << receivedData->getFullName() << ": " << e.what());
+                               }
+                           }, producer == m_config.peerPrefix ? 0 : m_config.recordFetchRetries,
+                           m_config.hintedFetchRetries,
+                           [](const Data &data, const ndn::security::ValidationError &error) {
+                               NDN_LOG_ERROR(
+                                       "Verification error on Received record " << data.getFullName() << ": "
+                                                                                << error.getInfo());
+                           }, [producer, seqId](auto &...) {
+                NDN_LOG_ERROR("Fetch timeout on Received record " << producer << " - Sequence Id " << seqId);
+            });
+}
+
+void MnemosyneDagLogger::addReceivedRecord(const Record &record, const Name &producer, svs::SeqNo seqId) {
+    NDN_LOG_DEBUG("Add record to ledger: " << record.getRecordFullName());
+    const shared_ptr<const Data> &recordData = record.getEncodedData();
 
     //backend update
     if (m_dagCollectedVersions.get(producer) + 1 != seqId) {
         NDN_LOG_WARN(
-                " - previous version does not have continuous version vector with " << record->getRecordFullName());
+                " - previous version does not have continuous version vector with " << record.getRecordFullName());
     }
     m_dagCollectedVersions.set(producer, seqId);
     m_backend->triggerBackup();
     m_backend->putRecord(recordData);
+    // it may have been found missing by a hinted Interest before it arrived
+    m_dagSync->onRecordStored(recordData->getName());
+    for (const auto &pointer: record.getPointersFromHeader()) {
+        if (!Record::isGenesisRecord(pointer)) {
+            m_backend->addReferencingRecord(pointer, recordData->getFullName());
+        }
+    }
+    m_dagReferenceChecker->addAcceptedRecord(recordData->getFullName());
+    if (m_antiEntropy) {
+        m_antiEntropy->addRecord(recordData->getFullName());
+    }
 
     //local update
-    m_lastRecordInChains[Record::getProducerPrefix(recordData->getName())] = std::make_pair(recordData->getFullName(), m_config.maxSelfReRefCount);
+    m_lastRecordInChains->update(Record::getProducerPrefix(recordData->getName()), recordData->getFullName(),
+                                 m_widthController->getSelfReRefCount());
+    m_lastRecordInChains->onRecordAccepted(record);
+    m_widthController->onRecordArrival();
+    m_immutabilityFrontier->recordUpdate(record);
+    bool isCheckpoint = record.getContentData() &&
+                        dag::Checkpoint::isCheckpointOf(record.getContentData()->getName(),
+                                                        Record::getProducerPrefix(recordData->getName()));
+    if (isCheckpoint) {
+        m_pendingCheckpoints.push_back(recordData->getFullName());
+    }
+    updateAgreedCheckpoint();
+    // checkpoints do not count, or they would trigger one another with no event in between
+    if (!isCheckpoint && m_config.checkpointRecordInterval > 0 &&
+        ++m_recordsSinceCheckpoint >= m_config.checkpointRecordInterval) {
+        m_recordsSinceCheckpoint = 0;
+        m_checkpointCreationEvent = m_scheduler.schedule(time::milliseconds(0), [this] { createCheckpoint(); });
+    }
+    if (!m_pendingRecords->empty()) {
+        // the tails may suffice now; retried once, after the records arriving together
+        m_pendingRecordEvent = m_scheduler.schedule(time::milliseconds(0), [this] { publishPendingRecords(); });
+    }
     if (producer == m_config.peerPrefix) {
-        m_KnownSelfSeqId = std::max(m_KnownSelfSeqId, Record::getRecordSeqId(record->getRecordFullName()));
+        m_KnownSelfSeqId = std::max(m_KnownSelfSeqId, Record::getRecordSeqId(record.getRecordFullName()));
     } else {
-        m_replicationCounter->recordUpdate(*record);
+        m_replicationCounter->recordUpdate(record);
+        notifyImmutableWaiters();
         if (m_onRecordCallback) {
-            m_onRecordCallback(*record);
+            m_onRecordCallback(record);
+        }
+    }
+}
+
+void MnemosyneDagLogger::createCheckpoint() {
+    std::vector<Name> tips;
+    for (const auto &[producer, seq]: m_dagCollectedVersions) {
+        if (seq == 0) continue;
+        auto listed = m_backend->listRecord(Record::getRecordName(producer, seq), 1);
+        if (!listed.empty()) {
+            tips.push_back(*listed.begin());
         }
     }
+    dag::Checkpoint checkpoint(m_dagCollectedVersions, std::move(tips));
+    Data data(dag::Checkpoint::makeCheckpointName(m_config.peerPrefix));
+    auto content = makeEmptyBlock(tlv::Content);
+    checkpoint.wireEncode(content);
+    data.setContent(content);
+    m_keychain.sign(data, security::signingByIdentity(m_config.peerPrefix));
+
+    Record record(data, m_config.peerPrefix);
+    auto ret = createRecord(record);
+    if (ret.success()) {
+        NDN_LOG_INFO("Created checkpoint " << data.getName() << " at " << m_dagCollectedVersions.toStr());
+    } else {
+        NDN_LOG_WARN("Checkpoint creation failed: " << ret.what());
+    }
+}
+
+void MnemosyneDagLogger::scheduleCheckpoint() {
+    m_checkpointEvent = m_scheduler.schedule(time::seconds(m_config.checkpointPeriod.count()), [this] {
+        createCheckpoint();
+        scheduleCheckpoint();
+    });
+}
+
+void MnemosyneDagLogger::scheduleAntiEntropy() {
+    m_antiEntropyEvent = m_scheduler.schedule(time::seconds(m_config.antiEntropyPeriod.count()), [this] {
+        m_antiEntropy->reconcile();
+        scheduleAntiEntropy();
+    });
+}
+
+void MnemosyneDagLogger::scheduleWaitingRecordEviction() {
+    // waiting records also expire while no records arrive
+    m_waitingRecordEviction = m_scheduler.schedule(time::seconds(1), [this] {
+        m_dagReferenceChecker->evictExpired();
+        scheduleWaitingRecordEviction();
+    });
+}
+
+void MnemosyneDagLogger::updateAgreedCheckpoint() {
+    // a later checkpoint supersedes the earlier ones
+    auto agreed = m_pendingCheckpoints.end();
+    for (auto it = m_pendingCheckpoints.begin(); it != m_pendingCheckpoints.end(); it++) {
+        if (m_immutabilityFrontier->isImmutable(*it)) agreed = it;
+    }
+    if (agreed == m_pendingCheckpoints.end()) return;
+
+    m_agreedCheckpoint = *agreed;
+    m_checkpointResponse = nullptr;
+    m_backend->placeMetaData(AGREED_CHECKPOINT_KEY, agreed->toUri(name::UriFormat::CANONICAL));
+    NDN_LOG_DEBUG("Checkpoint agreed: " << *agreed);
+    m_pendingCheckpoints.erase(m_pendingCheckpoints.begin(), std::next(agreed));
+}
+
+void MnemosyneDagLogger::onCheckpointInterest(const Interest &interest) {
+    if (!m_agreedCheckpoint) return;
+    if (!m_checkpointResponse) {
+        auto proof = getInclusionProof(*m_agreedCheckpoint, m_config.maxCountedReplication);
+        if (!proof) {
+            NDN_LOG_WARN("No proof for checkpoint " << *m_agreedCheckpoint);
+            return;
+        }
+
+        // the checkpoint record followed by the records that replicate it, fetched by name as they may not fit
+        // in one packet
+        auto response = std::make_shared<Data>(Name(m_config.hintPrefix).append("CHECKPOINT").appendVersion());
+        auto content = makeEmptyBlock(tlv::Content);
+        for (const auto &data: *proof) {
+            content.push_back(data->getFullName().wireEncode());
+        }
+        content.encode();
+        response->setContent(content);
+        response->setFreshnessPeriod(time::seconds(1));
+        m_keychain.sign(*response, security::signingByIdentity(m_config.peerPrefix));
+        m_checkpointResponse = response;
+    }
+    try {
+        m_face.put(*m_checkpointResponse);
+    } catch (const std::exception &e) {
+        NDN_LOG_ERROR("Failed to send checkpoint " << *m_agreedCheckpoint << ": " << e.what());
+    }
+}
+
+void MnemosyneDagLogger::bootstrapFromCheckpoint(int retries) {
+    m_bootstrapping = true;
+    Interest interest(Name(m_config.hintPrefix).append("CHECKPOINT"));
+    interest.setCanBePrefix(true);
+    interest.setMustBeFresh(true);
+    interest.setInterestLifetime(time::seconds(2));
+
+    auto onFailure = [this, retries](auto &&...) {
+        if (retries > 0) {
+            bootstrapFromCheckpoint(retries - 1);
+            return;
+        }
+        NDN_LOG_WARN("No checkpoint received, syncing from genesis");
+        finishBootstrap();
+    };
+    m_face.expressInterest(interest, [this](const Interest &, const Data &data) {
+        std::vector<Name> recordNames;
+        try {
+            const auto &content = data.getContent();
+            content.parse();
+            for (const auto &element: content.elements()) {
+                recordNames.emplace_back(element);
+            }
+        } catch (const std::exception &e) {
+            NDN_LOG_ERROR("Bad checkpoint response " << data.getName() << ": " << e.what());
+            recordNames.clear();
+        }
+        if (recordNames.empty()) {
+            NDN_LOG_ERROR("Checkpoint response " << data.getName() << " lists no record, syncing from genesis");
+            finishBootstrap();
+            return;
+        }
+        fetchCheckpointProof(recordNames);
+    }, onFailure, onFailure);
+}
+
+void MnemosyneDagLogger::fetchCheckpointProof(const std::vector<Name> &recordNames) {
+    auto proof = std::make_shared<std::vector<std::shared_ptr<const Data>>>(recordNames.size());
+    auto remaining = std::make_shared<size_t>(recordNames.size());
+    auto failed = std::make_shared<bool>(false);
+    for (size_t i = 0; i < recordNames.size(); i++) {
+        // the records are validated by the record validator before they arrive here
+        m_dagSync->fetchDataWithHint(recordNames[i], [this, proof, remaining, failed, i](const Data &data) {
+            if (*failed) return;
+            (*proof)[i] = std::make_shared<Data>(data);
+            if (--*remaining > 0) return;
+            if (dag::Checkpoint::verifyProof(*proof, m_config.maxCountedReplication)) {
+                adoptCheckpoint(proof->front());
+            } else {
+                NDN_LOG_ERROR("Checkpoint " << proof->front()->getName()
+                                            << " is not replicated enough, syncing from genesis");
+            }
+            finishBootstrap();
+        }, [this, failed](const Data &data, const ndn::security::ValidationError &error) {
+            if (*failed) return;
+            *failed = true;
+            NDN_LOG_ERROR("Verification error on checkpoint record " << data.getFullName() << ": "
+                                                                     << error.getInfo());
+            finishBootstrap();
+        }, [this, failed, recordName = recordNames[i]](auto &&...) {
+            if (*failed) return;
+            *failed = true;
+            NDN_LOG_ERROR("Fetch timeout on checkpoint record " << recordName << ", syncing from genesis");
+            finishBootstrap();
+        }, m_config.hintedFetchRetries);
+    }
+}
+
+void MnemosyneDagLogger::adoptCheckpoint(const std::shared_ptr<const Data> &checkpointRecord) {
+    std::optional<dag::Checkpoint> decoded;
+    try {
+        Record record(checkpointRecord);
+        decoded.emplace(record.getContentData().value());
+    } catch (const std::exception &e) {
+        NDN_LOG_ERROR("Bad checkpoint record " << checkpointRecord->getName() << ": " << e.what()
+                                               << ", syncing from genesis");
+        return;
+    }
+    const auto &checkpoint = *decoded;
+    for (const auto &[producer, seq]: checkpoint.getVersions()) {
+        if (seq <= m_dagCollectedVersions.get(producer)) continue;
+        m_dagCollectedVersions.set(producer, seq);
+        getGroupSync(producer).getCore().updateSeqNo(seq, producer);
+        if (producer == m_config.peerPrefix) {
+            m_KnownSelfSeqId = std::max(m_KnownSelfSeqId, seq);
+        }
+    }
+    for (const auto &tip: checkpoint.getTips()) {
+        auto producer = Record::getProducerPrefix(tip);
+        if (Record::getRecordSeqId(tip) == m_dagCollectedVersions.get(producer)) {
+            m_lastRecordInChains->update(producer, tip, m_widthController->getSelfReRefCount());
+        }
+    }
+    m_dagReferenceChecker->setCheckpoint(checkpoint.getVersions());
+    setAntiEntropyFloors(checkpoint.getVersions());
+
+    const auto &wire = checkpointRecord->wireEncode();
+    m_backend->placeMetaData(BOOTSTRAP_CHECKPOINT_KEY, std::string((const char *) wire.wire(), wire.size()));
+    versionBackupCallback();
+    NDN_LOG_INFO("Started from checkpoint " << checkpointRecord->getName() << " at "
+                                            << m_dagCollectedVersions.toStr());
+}
+
+void MnemosyneDagLogger::setAntiEntropyFloors(const svs::VersionVector &checkpointVersions) {
+    if (!m_antiEntropy) return;
+    for (const auto &[producer, seq]: checkpointVersions) {
+        m_antiEntropy->setFloor(producer, seq);
+    }
+}
+
+void MnemosyneDagLogger::finishBootstrap() {
+    m_bootstrapping = false;
+    auto updates = std::move(m_bootstrapUpdates);
+    m_bootstrapUpdates.clear();
+    if (!updates.empty()) {
+        onUpdate(updates);
+    }
 }
 
 const Name &MnemosyneDagLogger::getPeerPrefix() const {
     return m_config.peerPrefix;
 }
 
+std::set<Name> MnemosyneDagLogger::getSyncedProducers() {
+    auto producers = m_dagSync->getCore().getNodeIds();
+    for (const auto &listener: m_groupListeners) {
+        if (!listener) continue;
+        auto groupProducers = listener->getCore().getNodeIds();
+        producers.insert(groupProducers.begin(), groupProducers.end());
+    }
+    return producers;
+}
+
 bool MnemosyneDagLogger::versionBackupCallback() {
     auto backupPage = m_dagCollectedVersions.encode();
     backupPage.encode();
@@ -285,4 +779,25 @@ MnemosyneDagLogger::getSecurityOption(KeyChain &keychain, shared_ptr<ndn::securi
     return option;
 }
 
+dag::RecordSync &MnemosyneDagLogger::getGroupSync(const Name &producer) {
+    auto group = m_syncGroups->getGroup(producer);
+    return group == m_syncGroups->getOwnGroup() ? *m_dagSync : *m_groupListeners[group];
+}
+
+std::unique_ptr<TipSelectionPolicy> MnemosyneDagLogger::getTipSelectionPolicy(const LoggerConfig &config) {
+    if (config.tipSelectionPolicyFactory) {
+        return config.tipSelectionPolicyFactory(config);
+    }
+    std::string type = config.tipSelectionPolicy;
+    std::transform(type.begin(), type.end(), type.begin(), ::tolower);
+    if (type == "random") {
+        return std::make_unique<dag::TailingRecordSet>(
+                config.adaptiveWidth ? config.maxAdaptiveSelfReRefCount : config.maxSelfReRefCount);
+    }
+    if (type == "replication") {
+        return std::make_unique<dag::ReplicationAwareTipSelection>(config.maxCountedReplication);
+    }
+    NDN_THROW(std::runtime_error("Unknown tip selection policy: " + config.tipSelectionPolicy));
+}
+
 }  // namespace mnemosyne
\ No newline at end of file
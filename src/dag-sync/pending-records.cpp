@@ -0,0 +1,35 @@
+#include "pending-records.h"
+
+namespace mnemosyne::dag {
+
+PendingRecords::PendingRecords(Clock::duration timeout) :
+        m_timeout(timeout) {
+}
+
+void PendingRecords::push(Record record, Callback callback, Clock::time_point now) {
+    m_entries.push_back({std::move(record), std::move(callback), now});
+}
+
+std::vector<PendingRecords::Entry>
+PendingRecords::create(const std::function<void(Record &)> &create, const std::function<bool()> &canCreateNext) {
+    std::vector<Entry> created;
+    if (m_entries.empty()) return created;
+    do {
+        created.push_back(std::move(m_entries.front()));
+        m_entries.pop_front();
+        create(created.back().record);
+    } while (!m_entries.empty() && canCreateNext());
+    return created;
+}
+
+void PendingRecords::expire(Clock::time_point now) {
+    if (m_timeout == Clock::duration::zero()) return;
+    // records arrive in order, so the expired ones are at the front
+    while (!m_entries.empty() && m_entries.front().arrival + m_timeout <= now) {
+        auto callback = std::move(m_entries.front().callback);
+        m_entries.pop_front();
+        if (callback) callback(ReturnCode::timingError("Not enough tailing records within the timeout"));
+    }
+}
+
+} // namespace mnemosyne::dag
@@ -0,0 +1,63 @@
+#ifndef MNEMOSYNE_PENDING_RECORDS_H
+#define MNEMOSYNE_PENDING_RECORDS_H
+
+#include "mnemosyne/record.hpp"
+#include "mnemosyne/return-code.hpp"
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <vector>
+
+namespace mnemosyne::dag {
+
+/**
+ * Records of this logger waiting, in order, for enough tailing records to be created.
+ * A record that waits longer than the timeout is completed with ReturnCode::timingError instead.
+ */
+class PendingRecords {
+  public:
+    using Clock = std::chrono::steady_clock;
+    using Callback = std::function<void(ReturnCode result)>;
+
+    struct Entry {
+        Record record;
+        Callback callback;
+        Clock::time_point arrival;
+    };
+
+    /**
+     * @p timeout, how long a record may wait; 0 for no limit
+     */
+    explicit PendingRecords(Clock::duration timeout);
+
+    void push(Record record, Callback callback, Clock::time_point now = Clock::now());
+
+    /**
+     * Create the pending records in order with @p create: the first one at once, and each next one while
+     * @p canCreateNext holds.
+     * @return the created records, whose callbacks are left to the caller once they are announced
+     */
+    std::vector<Entry> create(const std::function<void(Record &)> &create,
+                              const std::function<bool()> &canCreateNext);
+
+    /**
+     * Complete the records that waited longer than the timeout with ReturnCode::timingError.
+     */
+    void expire(Clock::time_point now = Clock::now());
+
+    bool empty() const {
+        return m_entries.empty();
+    }
+
+    size_t size() const {
+        return m_entries.size();
+    }
+
+  private:
+    Clock::duration m_timeout;
+    std::deque<Entry> m_entries;
+};
+
+} // namespace mnemosyne::dag
+
+#endif //MNEMOSYNE_PENDING_RECORDS_H
@@ -0,0 +1,48 @@
+#include "range-reconciler.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace mnemosyne::dag {
+
+RangeReconciler::Step
+RangeReconciler::compareRoot(const MerkleRangeTree &local, uint64_t floor, size_t remoteHeight,
+                             const MerkleRangeTree::Digest &remoteRoot) {
+    Step step;
+    auto height = std::max(remoteHeight, local.getHeight());
+    if (MerkleRangeTree::lift(remoteRoot, remoteHeight, height) == local.get(height, 0)) return step;
+    // a single leaf is sequence number 0, which is never a record
+    if (height == 0 || isBelow(height, 0, floor)) return step;
+    step.requests.push_back({height, 0});
+    return step;
+}
+
+RangeReconciler::Step
+RangeReconciler::compareChildren(const MerkleRangeTree &local, uint64_t floor, size_t level, uint64_t index,
+                                 const std::array<MerkleRangeTree::Digest, 2> &remote) {
+    Step step;
+    if (level == 0) return step;
+    for (uint64_t i = 0; i < 2; i++) {
+        auto childIndex = 2 * index + i;
+        if (isBelow(level - 1, childIndex, floor)) continue;
+        auto localChild = local.get(level - 1, childIndex);
+        if (localChild == remote[i]) continue;
+        if (level - 1 > 0) {
+            step.requests.push_back({level - 1, childIndex});
+        } else if (localChild == MerkleRangeTree::EMPTY) {
+            step.missing.push_back(childIndex);
+        } else if (remote[i] != MerkleRangeTree::EMPTY) {
+            step.conflicting.push_back(childIndex);
+        }
+    }
+    return step;
+}
+
+bool RangeReconciler::isBelow(size_t level, uint64_t index, uint64_t floor) {
+    if (floor == 0) return false;
+    if (level >= std::numeric_limits<uint64_t>::digits) return false;
+    // the last sequence number of the node, which cannot overflow for the nodes of a chain
+    return ((index + 1) << level) - 1 <= floor;
+}
+
+} // namespace mnemosyne::dag
@@ -0,0 +1,54 @@
+#ifndef MNEMOSYNE_RANGE_RECONCILER_H
+#define MNEMOSYNE_RANGE_RECONCILER_H
+
+#include "merkle-range-tree.h"
+
+#include <array>
+#include <vector>
+
+namespace mnemosyne::dag {
+
+/**
+ * The steps of comparing a peer's MerkleRangeTree of one producer with the local one, node by node from the root.
+ * The sequence numbers up to a floor are left out, as a logger started from a checkpoint lacks the records up to it:
+ * the nodes covering only those are skipped, and those covering the floor are descended like differing ones, so a
+ * floor costs a path of nodes rather than a walk over the records below it.
+ */
+class RangeReconciler {
+  public:
+    struct Node {
+        size_t level;
+        uint64_t index;
+    };
+
+    struct Step {
+        // nodes whose children to request from the peer
+        std::vector<Node> requests;
+        // sequence numbers the peer has and the local tree does not
+        std::vector<uint64_t> missing;
+        // sequence numbers with a different digest on each side
+        std::vector<uint64_t> conflicting;
+    };
+
+    /**
+     * @p floor, the highest sequence number left out, 0 for none
+     */
+    static Step compareRoot(const MerkleRangeTree &local, uint64_t floor, size_t remoteHeight,
+                            const MerkleRangeTree::Digest &remoteRoot);
+
+    /**
+     * @p remote, the peer's children of node (@p level, @p index)
+     */
+    static Step compareChildren(const MerkleRangeTree &local, uint64_t floor, size_t level, uint64_t index,
+                                const std::array<MerkleRangeTree::Digest, 2> &remote);
+
+  private:
+    /**
+     * @return whether node (@p level, @p index) covers sequence numbers up to @p floor only
+     */
+    static bool isBelow(size_t level, uint64_t index, uint64_t floor);
+};
+
+} // namespace mnemosyne::dag
+
+#endif //MNEMOSYNE_RANGE_RECONCILER_H
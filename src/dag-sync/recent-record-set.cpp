@@ -0,0 +1,35 @@
+#include "recent-record-set.h"
+
+mnemosyne::dag::RecentRecordSet::RecentRecordSet(size_t capacity) :
+        m_next(0),
+        m_capacity(capacity) {
+    m_digests.reserve(capacity);
+}
+
+void mnemosyne::dag::RecentRecordSet::insert(const ndn::Name &recordFullName) {
+    Digest digest;
+    if (m_capacity == 0 || !getDigest(recordFullName, digest)) return;
+    if (!m_digests.insert(digest).second) return;
+
+    if (m_insertionOrder.size() < m_capacity) {
+        m_insertionOrder.push_back(digest);
+        return;
+    }
+    m_digests.erase(m_insertionOrder[m_next]);
+    m_insertionOrder[m_next] = digest;
+    m_next = (m_next + 1) % m_capacity;
+}
+
+bool mnemosyne::dag::RecentRecordSet::contains(const ndn::Name &recordFullName) const {
+    Digest digest;
+    if (!getDigest(recordFullName, digest)) return false;
+    return m_digests.count(digest) != 0;
+}
+
+bool mnemosyne::dag::RecentRecordSet::getDigest(const ndn::Name &recordFullName, Digest &digest) {
+    if (recordFullName.empty()) return false;
+    const auto &component = recordFullName.get(-1);
+    if (!component.isImplicitSha256Digest() || component.value_size() != digest.size()) return false;
+    std::memcpy(digest.data(), component.value(), digest.size());
+    return true;
+}
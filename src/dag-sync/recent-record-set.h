@@ -0,0 +1,50 @@
+#ifndef MNEMOSYNE_RECENT_RECORD_SET_H
+#define MNEMOSYNE_RECENT_RECORD_SET_H
+
+#include <ndn-cxx/name.hpp>
+#include <array>
+#include <cstring>
+#include <unordered_set>
+#include <vector>
+
+namespace mnemosyne::dag {
+
+/**
+ * A bounded set of the implicit digests of recently accepted records.
+ * Once the capacity is reached, the oldest digests are forgotten.
+ */
+class RecentRecordSet {
+  public:
+    explicit RecentRecordSet(size_t capacity);
+
+    /**
+     * @param recordFullName the full name of an accepted record; names without a digest are ignored
+     */
+    void insert(const ndn::Name &recordFullName);
+
+    bool contains(const ndn::Name &recordFullName) const;
+
+  private:
+    using Digest = std::array<uint8_t, 32>;
+
+    struct DigestHash {
+        size_t operator()(const Digest &digest) const {
+            // digests are uniformly distributed already
+            size_t h;
+            std::memcpy(&h, digest.data(), sizeof(h));
+            return h;
+        }
+    };
+
+    static bool getDigest(const ndn::Name &recordFullName, Digest &digest);
+
+  private:
+    std::unordered_set<Digest, DigestHash> m_digests;
+    std::vector<Digest> m_insertionOrder;
+    size_t m_next;
+    size_t m_capacity;
+};
+
+} // namespace mnemosyne::dag
+
+#endif //MNEMOSYNE_RECENT_RECORD_SET_H
@@ -10,20 +10,29 @@
 
 NDN_LOG_INIT(mnemosyne.dag.RecordSync);
 
+const size_t mnemosyne::dag::RecordSync::HINTED_FETCH_CACHE_SIZE = 1024;
+const mnemosyne::dag::HintedFetchCache::Clock::duration mnemosyne::dag::RecordSync::MISSING_RECORD_LIFETIME =
+        std::chrono::seconds(1);
+
 mnemosyne::dag::RecordSync::RecordSync(const ndn::Name &syncPrefix,
                                        const ndn::Name &nodePrefix,
                                        const ndn::Name &hintPrefix,
                                        ndn::Face &face,
                                        const ndn::svs::UpdateCallback &updateCallback,
                                        std::weak_ptr<Backend> backend,
-                                       const ndn::svs::SecurityOptions &securityOptions)
+                                       const ndn::svs::SecurityOptions &securityOptions,
+                                       bool serveHintedInterests)
         : SVSyncBase(syncPrefix, nodePrefix, nodePrefix,
                      face, updateCallback, securityOptions, make_shared<BackendDataStore>(std::move(backend))),
           m_face(face),
           m_hintPrefix(hintPrefix),
+          m_hintedFetchCache(HINTED_FETCH_CACHE_SIZE, MISSING_RECORD_LIFETIME),
           m_fetcher(face, securityOptions) {
+    if (!serveHintedInterests) return;
     m_registerHintPrefix = m_face.registerPrefix(hintPrefix, [this](auto &&...) {
-        m_registerFilterHandle = m_face.setInterestFilter("/", std::bind(&RecordSync::onDataInterest, this, _2));
+        // hinted Interests carry the record name, under any producer prefix
+        m_registerFilterHandle = m_face.setInterestFilter(ndn::InterestFilter("/", "^<>*<RECORD><>{1,2}$"),
+                                                          std::bind(&RecordSync::onDataInterest, this, _2));
     }, [](auto &&...) {
         NDN_LOG_FATAL("Error: Hint prefix registration failed");
     });
@@ -35,10 +44,11 @@ mnemosyne::dag::RecordSync::~RecordSync() {
     m_registerFilterHandle.cancel();
 }
 
-svs::SeqNo mnemosyne::dag::RecordSync::publishData(Record &record, const ndn::time::milliseconds &freshness,
-                                                   const svs::NodeID &id, uint32_t contentType) {
+svs::SeqNo mnemosyne::dag::RecordSync::prepareData(Record &record, const ndn::time::milliseconds &freshness,
+                                                   const svs::NodeID &id, uint32_t contentType,
+                                                   svs::SeqNo seq) {
     svs::NodeID pubId = id != EMPTY_NODE_ID ? id : m_id;
-    svs::SeqNo newSeq = getCore().getSeqNo(pubId) + 1;
+    svs::SeqNo newSeq = seq != 0 ? seq : getCore().getSeqNo(pubId) + 1;
 
     Name dataName = getDataName(pubId, newSeq);
 
@@ -51,13 +61,32 @@ svs::SeqNo mnemosyne::dag::RecordSync::publishData(Record &record, const ndn::ti
     m_securityOptions.dataSigner->sign(*data);
     record.setEncodedData(data);
 
-    getDataStore().insert(*data);
-    getCore().updateSeqNo(newSeq, pubId);
-    m_face.put(*data);
-
     return newSeq;
 }
 
+void mnemosyne::dag::RecordSync::announceData(const Data &data, const svs::NodeID &id, svs::SeqNo seq) {
+    svs::NodeID pubId = id != EMPTY_NODE_ID ? id : m_id;
+    m_hintedFetchCache.eraseMissing(data.getName());
+    getCore().updateSeqNo(seq, pubId);
+    m_face.put(data);
+}
+
+void mnemosyne::dag::RecordSync::announceData(const std::vector<std::shared_ptr<const Data>> &data,
+                                              const svs::NodeID &id, svs::SeqNo lastSeq) {
+    svs::NodeID pubId = id != EMPTY_NODE_ID ? id : m_id;
+    for (const auto &item: data) {
+        m_hintedFetchCache.eraseMissing(item->getName());
+    }
+    getCore().updateSeqNo(lastSeq, pubId);
+    for (const auto &item: data) {
+        m_face.put(*item);
+    }
+}
+
+void mnemosyne::dag::RecordSync::onRecordStored(const Name &recordName) {
+    m_hintedFetchCache.eraseMissing(recordName);
+}
+
 void mnemosyne::dag::RecordSync::fetchRecord(const svs::NodeID &nid, const svs::SeqNo &seq,
                                              const svs::DataValidatedCallback &onValidated, int nRetries,
                                              int forwardingHintRetries,
@@ -73,8 +102,14 @@ void mnemosyne::dag::RecordSync::fetchDataWithHint(const svs::NodeID &nid, const
                                                    const svs::DataValidatedCallback &onValidated,
                                                    const svs::DataValidationErrorCallback &onValidationFailed,
                                                    const TimeoutCallback &onTimeout, int nRetries) {
-    Name interestName = getDataName(nid, seq);
-    Interest interest(interestName);
+    fetchDataWithHint(getDataName(nid, seq), onValidated, onValidationFailed, onTimeout, nRetries);
+}
+
+void mnemosyne::dag::RecordSync::fetchDataWithHint(const Name &recordName,
+                                                   const svs::DataValidatedCallback &onValidated,
+                                                   const svs::DataValidationErrorCallback &onValidationFailed,
+                                                   const TimeoutCallback &onTimeout, int nRetries) {
+    Interest interest(recordName);
     interest.setCanBePrefix(true);
     interest.setForwardingHint({m_hintPrefix});
     interest.setInterestLifetime(ndn::time::milliseconds(2000));
@@ -99,8 +134,28 @@ void mnemosyne::dag::RecordSync::onDataInterest(const Interest &interest) {
     for (const Name &hintName: interest.getForwardingHint()) {
         if (m_hintPrefix.isPrefixOf(hintName)) {
             NDN_LOG_DEBUG("Hinted face incoming: " << interest.getName());
-            auto data = getDataStore().find(interest);
-            if (data != nullptr)
+            if (!Record::isRecordName(interest.getName())) return;
+            auto recordName = interest.getName();
+            if (recordName.get(-1).isImplicitSha256Digest()) recordName = recordName.getPrefix(-1);
+
+            auto data = m_hintedFetchCache.findServed(recordName);
+            if (data != nullptr && !interest.matchesData(*data)) {
+                // another record under the same name, so the one of the requested digest may still be stored
+                data = getDataStore().find(interest);
+                if (data != nullptr && interest.matchesData(*data))
+                    m_face.put(*data);
+                return;
+            }
+            if (data == nullptr) {
+                if (m_hintedFetchCache.isMissing(recordName)) return;
+                data = getDataStore().find(interest);
+                if (data == nullptr) {
+                    m_hintedFetchCache.insertMissing(recordName);
+                    return;
+                }
+                m_hintedFetchCache.insertServed(recordName, data);
+            }
+            if (interest.matchesData(*data))
                 m_face.put(*data);
             return;
         }
@@ -19,6 +19,7 @@
 
 #include "mnemosyne/record.hpp"
 #include "mnemosyne/backend.hpp"
+#include "hinted-fetch-cache.h"
 
 #include <ndn-svs/svsync-base.hpp>
 
@@ -39,7 +40,8 @@ class RecordSync : public svs::SVSyncBase {
                ndn::Face &face,
                const ndn::svs::UpdateCallback &updateCallback,
                std::weak_ptr<Backend> backend,
-               const ndn::svs::SecurityOptions &securityOptions = ndn::svs::SecurityOptions::DEFAULT);
+               const ndn::svs::SecurityOptions &securityOptions = ndn::svs::SecurityOptions::DEFAULT,
+               bool serveHintedInterests = true);
 
     ~RecordSync();
 
@@ -47,8 +49,32 @@ class RecordSync : public svs::SVSyncBase {
         return Record::getRecordName(nid, seqNo);
     }
 
-    svs::SeqNo publishData(Record &record, const ndn::time::milliseconds &freshness, const svs::NodeID &id,
-                           uint32_t contentType);
+    /**
+     * @brief Encode and sign @p record as the next data of @p id, without storing or announcing it
+     *
+     * The signed data is set as the encoded data of @p record. The caller persists it before calling announceData.
+     * @p seq, the sequence number to use, 0 for the one after the last announced. Data prepared together before being
+     * announced take consecutive numbers.
+     * @return the sequence number of the data
+     */
+    svs::SeqNo prepareData(Record &record, const ndn::time::milliseconds &freshness, const svs::NodeID &id,
+                           uint32_t contentType, svs::SeqNo seq = 0);
+
+    /**
+     * @brief Announce the data prepared with @p seq in the sync group
+     */
+    void announceData(const Data &data, const svs::NodeID &id, svs::SeqNo seq);
+
+    /**
+     * @brief Announce the data prepared with consecutive numbers up to @p lastSeq, with a single sync update
+     */
+    void announceData(const std::vector<std::shared_ptr<const Data>> &data, const svs::NodeID &id,
+                      svs::SeqNo lastSeq);
+
+    /**
+     * Forget that the record @p recordName was missing from the storage, once it is stored.
+     */
+    void onRecordStored(const Name &recordName);
 
     /**
      * @brief Retrieve a data packet with a particular seqNo from a session
@@ -85,6 +111,16 @@ class RecordSync : public svs::SVSyncBase {
                       const TimeoutCallback &onTimeout,
                       int nRetries = 0);
 
+    /**
+     * @brief Retrieve the record @p recordName, a full name or not, with the forwarding hint
+     */
+    void
+    fetchDataWithHint(const ndn::Name &recordName,
+                      const ndn::svs::DataValidatedCallback &onValidated,
+                      const ndn::svs::DataValidationErrorCallback &onValidationFailed,
+                      const TimeoutCallback &onTimeout,
+                      int nRetries = 0);
+
   private:
     void onDataValidated(const Data &data, const svs::DataValidatedCallback &dataCallback);
 
@@ -107,8 +143,12 @@ class RecordSync : public svs::SVSyncBase {
         std::weak_ptr<Backend> m_backend;
     };
 
+    static const size_t HINTED_FETCH_CACHE_SIZE;
+    static const HintedFetchCache::Clock::duration MISSING_RECORD_LIFETIME;
+
     ndn::Face &m_face;
     ndn::Name m_hintPrefix;
+    HintedFetchCache m_hintedFetchCache;
     ndn::svs::Fetcher m_fetcher;
     ndn::ScopedRegisteredPrefixHandle m_registerHintPrefix;
     ndn::InterestFilterHandle m_registerFilterHandle;
@@ -0,0 +1,114 @@
+#include "replication-aware-tip-selection.h"
+
+#include <algorithm>
+
+namespace mnemosyne::dag {
+
+ReplicationAwareTipSelection::ReplicationAwareTipSelection(uint32_t maxReplication) :
+        m_buckets(maxReplication + 1) {
+}
+
+const Name &ReplicationAwareTipSelection::getRecord(const Name &producer) const {
+    return m_tails.at(producer).recordName;
+}
+
+void ReplicationAwareTipSelection::update(const Name &producer, const Name &recordFullName, uint32_t refCount) {
+    auto it = m_tails.find(producer);
+    if (it == m_tails.end()) {
+        it = m_tails.emplace(producer, Tail{recordFullName, Record::getRecordSeqId(recordFullName), refCount, {}, 0})
+                .first;
+        addToBucket(*it);
+        return;
+    }
+    it->second.refCount = refCount;
+    if (it->second.recordName == recordFullName) return;
+    // a new tail has not been referenced by anyone yet
+    removeFromBucket(*it);
+    it->second.recordName = recordFullName;
+    it->second.seqId = Record::getRecordSeqId(recordFullName);
+    it->second.replicators.clear();
+    addToBucket(*it);
+}
+
+void ReplicationAwareTipSelection::erase(const Name &producer) {
+    auto it = m_tails.find(producer);
+    if (it == m_tails.end()) return;
+    removeFromBucket(*it);
+    m_tails.erase(it);
+}
+
+void ReplicationAwareTipSelection::selectInto(Record &record, size_t num, std::mt19937_64 &randomEngine) {
+    // find the highest count such that tails with that count or lower are enough
+    size_t threshold = 0;
+    size_t candidates = m_buckets[0].size();
+    while (candidates < num && threshold + 1 < m_buckets.size()) {
+        threshold++;
+        candidates += m_buckets[threshold].size();
+    }
+    if (candidates < num) {
+        NDN_THROW(std::runtime_error("Not enough tailing records to select from"));
+    }
+
+    // selection does not move a tail between buckets, so pick all first and consume afterwards
+    m_selected.clear();
+    for (size_t count = 0; count < threshold; count++) {
+        m_selected.insert(m_selected.end(), m_buckets[count].begin(), m_buckets[count].end());
+    }
+    auto &bucket = m_buckets[threshold];
+    for (size_t i = 0; m_selected.size() < num; i++) {
+        std::uniform_int_distribution<size_t> distribution(i, bucket.size() - 1);
+        auto j = distribution(randomEngine);
+        std::swap(bucket[i], bucket[j]);
+        bucket[i]->second.position = i;
+        bucket[j]->second.position = j;
+        m_selected.push_back(bucket[i]);
+    }
+    for (auto entry: m_selected) {
+        record.addPointer(entry->second.recordName);
+        consume(*entry);
+    }
+}
+
+void ReplicationAwareTipSelection::onRecordAccepted(const Record &record) {
+    auto producer = Record::getProducerPrefix(record.getEncodedData()->getName());
+    for (const auto &pointer: record.getPointersFromHeader()) {
+        auto it = m_tails.find(Record::getProducerPrefix(pointer));
+        if (it == m_tails.end() || it->first == producer) continue;
+        auto &tail = it->second;
+        if (Record::getRecordSeqId(pointer) < tail.seqId) continue;
+        if (tail.replicators.size() + 1 >= m_buckets.size()) continue;
+        if (std::find(tail.replicators.begin(), tail.replicators.end(), producer) != tail.replicators.end()) continue;
+        removeFromBucket(*it);
+        tail.replicators.push_back(producer);
+        addToBucket(*it);
+    }
+}
+
+size_t ReplicationAwareTipSelection::getBucketId(const Tail &tail) const {
+    return tail.replicators.size();
+}
+
+void ReplicationAwareTipSelection::addToBucket(Entry &entry) {
+    auto &bucket = m_buckets[getBucketId(entry.second)];
+    entry.second.position = bucket.size();
+    bucket.push_back(&entry);
+}
+
+void ReplicationAwareTipSelection::removeFromBucket(Entry &entry) {
+    auto &bucket = m_buckets[getBucketId(entry.second)];
+    auto last = bucket.back();
+    bucket[entry.second.position] = last;
+    last->second.position = entry.second.position;
+    bucket.pop_back();
+}
+
+void ReplicationAwareTipSelection::consume(Entry &entry) {
+    if (entry.second.refCount <= 1) {
+        removeFromBucket(entry);
+        m_tails.erase(m_tails.find(entry.first));
+        return;
+    }
+    entry.second.refCount--;
+}
+
+} // namespace mnemosyne::dag
@@ -0,0 +1,71 @@
+#ifndef MNEMOSYNE_REPLICATION_AWARE_TIP_SELECTION_H
+#define MNEMOSYNE_REPLICATION_AWARE_TIP_SELECTION_H
+
+#include "mnemosyne/tip-selection-policy.hpp"
+#include <ndn-cxx/name.hpp>
+#include <ndn-cxx/util/exception.hpp>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+namespace mnemosyne::dag {
+
+/**
+ * The "replication" tip selection policy.
+ * For each tailing record, count the distinct producers whose accepted records reference it (or a later record of
+ * the same chain), up to maxReplication. Tails referenced by the fewest producers are preferred, so that the chains
+ * furthest from being counted as replicated are the ones this logger helps along.
+ * Tails are kept in buckets by that count, so that selecting k preceding records costs O(k).
+ */
+class ReplicationAwareTipSelection : public TipSelectionPolicy {
+  public:
+    explicit ReplicationAwareTipSelection(uint32_t maxReplication);
+
+    size_t size() const override {
+        return m_tails.size();
+    }
+
+    bool contains(const ndn::Name &producer) const override {
+        return m_tails.count(producer) != 0;
+    }
+
+    const ndn::Name &getRecord(const ndn::Name &producer) const override;
+
+    void update(const ndn::Name &producer, const ndn::Name &recordFullName, uint32_t refCount) override;
+
+    void erase(const ndn::Name &producer) override;
+
+    /**
+     * Tails with the fewest referencing producers are preferred, chosen uniformly at random within a count.
+     */
+    void selectInto(Record &record, size_t num, std::mt19937_64 &randomEngine) override;
+
+    void onRecordAccepted(const Record &record) override;
+
+  private:
+    struct Tail {
+        ndn::Name recordName;
+        uint64_t seqId;
+        uint32_t refCount;
+        std::vector<ndn::Name> replicators;
+        size_t position;
+    };
+    using Entry = std::pair<const ndn::Name, Tail>;
+
+    size_t getBucketId(const Tail &tail) const;
+
+    void addToBucket(Entry &entry);
+
+    void removeFromBucket(Entry &entry);
+
+    void consume(Entry &entry);
+
+  private:
+    std::unordered_map<ndn::Name, Tail> m_tails;
+    std::vector<std::vector<Entry *>> m_buckets;
+    std::vector<Entry *> m_selected;
+};
+
+} // namespace mnemosyne::dag
+
+#endif //MNEMOSYNE_REPLICATION_AWARE_TIP_SELECTION_H
@@ -5,6 +5,7 @@
 #include "replication-counter.h"
 #include <ndn-cxx/util/logger.hpp>
 #include <ndn-cxx/util/logging.hpp>
+#include <iterator>
 #include <utility>
 
 NDN_LOG_INIT(mnemosyne.dagsync.replicationCounter);
@@ -17,31 +18,21 @@ mnemosyne::dag::ReplicationCounter::ReplicationCounter(ndn::Name peerPrefix, uin
 std::list<uint64_t> mnemosyne::dag::ReplicationCounter::getCounts() const {
     std::list<uint64_t> ans;
     if (m_maxReference <= 0) return ans;
-    for (const auto& i: m_locations) {
-        for (size_t j = i.second.size(); j > 0; j --)
-            ans.push_back(i.first);
-    }
-    assert(ans.size() == getLocationSize());
-    while (ans.size() > m_maxReference) {
-        ans.pop_front();
-    }
-    if (ans.front() > m_locations.begin()->first) {
-        NDN_LOG_ERROR("Weight counter size error - extra element: " << ans.front() << ">" << m_locations.begin()->first);
-        NDN_THROW(std::runtime_error("Weight counter size error"));
+    auto it = m_locations.rbegin();
+    for (uint32_t i = 0; i < m_maxReference && it != m_locations.rend(); i++, it++) {
+        ans.push_front(it->first);
     }
     return ans;
 }
 
 uint64_t mnemosyne::dag::ReplicationCounter::getMaxReferenceSeqNo() const {
     if (m_maxReference <= 0) return 0;
-    auto locationSize = getLocationSize();
-    if (locationSize < m_maxReference) return 0;
-    if (locationSize - m_locations.begin()->second.size() >= m_maxReference) {
-        NDN_LOG_ERROR("Weight counter size error - extra element: " << locationSize << " with first loc size" <<
-            m_locations.begin()->second.size());
-        NDN_THROW(std::runtime_error("Weight counter size error"));
-    }
-    return m_locations.begin()->first;
+    return getKthLocation(m_maxReference);
+}
+
+uint64_t mnemosyne::dag::ReplicationCounter::getKthLocation(uint32_t k) const {
+    if (k == 0 || m_locations.size() < k) return 0;
+    return std::prev(m_locations.end(), k)->first;
 }
 
 void mnemosyne::dag::ReplicationCounter::recordUpdate(const mnemosyne::Record &record) {
@@ -94,21 +85,34 @@ void mnemosyne::dag::ReplicationCounter::recordUpdate(const mnemosyne::Record &r
             } else break;
         }
         if (currentTopRef >= pointedTo) return;
-        auto location_it = m_locations.find(currentTopRef);
-        assert(location_it->second.erase(producer));
-        if (location_it->second.empty()) {
-            m_locations.erase(location_it);
-        }
     }
 
-    m_locations[pointedTo].insert(producer);
-    auto locationSize = getLocationSize();
-    if (locationSize < m_maxReference) return;
-    if (locationSize - m_locations.begin()->second.size() >= m_maxReference) {
-        for (const auto& n : m_locations.begin()->second) {
-            m_referencePoints.erase(n);
+    setLocation(producer, pointedTo);
+    if (m_locations.size() <= m_maxReference) return;
+    // drop the lowest location once it is no longer among the highest max reference ones
+    auto lowest = m_locations.begin()->first;
+    if (getKthLocation(m_maxReference) > lowest) {
+        auto range = m_locations.equal_range(lowest);
+        for (auto it = range.first; it != range.second; it++) {
+            m_referencePoints.erase(it->second);
+            m_producerLocations.erase(it->second);
         }
-        m_locations.erase(m_locations.begin());
+        m_locations.erase(range.first, range.second);
+    }
+}
+
+bool mnemosyne::dag::ReplicationCounter::hasReferencePoints(const Name &producer) const {
+    auto it = m_referencePoints.find(producer);
+    return it != m_referencePoints.end() && !it->second.empty();
+}
+
+void mnemosyne::dag::ReplicationCounter::setLocation(const Name &producer, uint64_t location) {
+    auto it = m_producerLocations.find(producer);
+    if (it == m_producerLocations.end()) {
+        m_producerLocations.emplace(producer, m_locations.emplace(location, producer));
+    } else {
+        m_locations.erase(it->second);
+        it->second = m_locations.emplace(location, producer);
     }
 }
 
@@ -121,11 +125,3 @@ std::map<uint64_t, uint64_t> &mnemosyne::dag::ReplicationCounter::getPrunedRefPo
     }
     return refPointSet;
 }
-
-uint32_t mnemosyne::dag::ReplicationCounter::getLocationSize() const {
-    uint64_t s = 0;
-    for (const auto& i: m_locations) {
-        s += i.second.size();
-    }
-    return (uint32_t) s;
-}
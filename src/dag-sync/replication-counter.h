@@ -25,13 +25,26 @@ class ReplicationCounter {
 
     uint64_t getMaxReferenceSeqNo() const;
 
+    /**
+     * @return the highest sequence number along this logger's chain that is replicated at @p k or more locations,
+     * or 0 if there are fewer than @p k locations. Costs O(k); k is at most the max reference.
+     */
+    uint64_t getKthLocation(uint32_t k) const;
+
     void recordUpdate(const Record &record);
 
+    /**
+     * @return whether records of @p producer currently carry references to this logger's chain
+     */
+    bool hasReferencePoints(const ndn::Name &producer) const;
+
   private:
-    uint32_t getLocationSize() const;
+    void setLocation(const ndn::Name &producer, uint64_t location);
 
   private:
-    std::map<uint64_t, std::set<ndn::Name>> m_locations;
+    // location (sequence number along this logger's chain) -> producer holding it, one entry per producer
+    std::multimap<uint64_t, ndn::Name> m_locations;
+    std::unordered_map<ndn::Name, std::multimap<uint64_t, ndn::Name>::iterator> m_producerLocations;
     std::unordered_map<ndn::Name, std::map<uint64_t, uint64_t>> m_referencePoints;
     ndn::Name m_peerPrefix;
     uint32_t m_maxReference;
@@ -0,0 +1,99 @@
+#ifndef MNEMOSYNE_SUBMISSION_QUEUE_H
+#define MNEMOSYNE_SUBMISSION_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+namespace mnemosyne::dag {
+
+/**
+ * Bounded lock-free queue that any thread may push to, and a single thread pops from.
+ * Each slot carries a sequence number telling whether it is free for the push of a given position or holds the
+ * item for the pop of that position, so producers only contend on the tail position.
+ * The capacity is rounded up to a power of two.
+ */
+template<typename T>
+class SubmissionQueue {
+  public:
+    explicit SubmissionQueue(size_t capacity) :
+            m_mask(roundUp(capacity) - 1),
+            m_slots(new Slot[m_mask + 1]),
+            m_tail(0),
+            m_head(0) {
+        for (size_t i = 0; i <= m_mask; i++) {
+            m_slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    SubmissionQueue(const SubmissionQueue &) = delete;
+
+    SubmissionQueue &operator=(const SubmissionQueue &) = delete;
+
+    /**
+     * @return false, leaving @p item untouched, if the queue is full
+     */
+    bool push(T &item) {
+        auto position = m_tail.load(std::memory_order_relaxed);
+        while (true) {
+            auto &slot = m_slots[position & m_mask];
+            auto sequence = slot.sequence.load(std::memory_order_acquire);
+            auto diff = (intptr_t) sequence - (intptr_t) position;
+            if (diff == 0) {
+                if (m_tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    slot.item = std::move(item);
+                    slot.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                // the slot still holds the item of the previous round
+                return false;
+            } else {
+                position = m_tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * Only call from the consuming thread.
+     * @return the oldest item, nullopt if the queue is empty or its oldest push has not completed yet
+     */
+    std::optional<T> pop() {
+        auto &slot = m_slots[m_head & m_mask];
+        if (slot.sequence.load(std::memory_order_acquire) != m_head + 1) return std::nullopt;
+        std::optional<T> item(std::move(*slot.item));
+        slot.item.reset();
+        slot.sequence.store(m_head + m_mask + 1, std::memory_order_release);
+        m_head++;
+        return item;
+    }
+
+    size_t capacity() const {
+        return m_mask + 1;
+    }
+
+  private:
+    static size_t roundUp(size_t capacity) {
+        size_t size = 1;
+        while (size < capacity) size <<= 1;
+        return size;
+    }
+
+  private:
+    struct Slot {
+        std::atomic<size_t> sequence;
+        std::optional<T> item;
+    };
+
+    const size_t m_mask;
+    std::unique_ptr<Slot[]> m_slots;
+    // pushed by producers; kept on its own cache line, away from the consumer's head
+    alignas(64) std::atomic<size_t> m_tail;
+    alignas(64) size_t m_head;
+};
+
+} // namespace mnemosyne::dag
+
+#endif //MNEMOSYNE_SUBMISSION_QUEUE_H
@@ -0,0 +1,33 @@
+#include "sync-groups.h"
+#include "mnemosyne/record.hpp"
+
+namespace mnemosyne::dag {
+
+SyncGroups::SyncGroups(const ndn::Name &syncPrefix, const ndn::Name &peerPrefix, uint32_t groupCount) :
+        m_syncPrefix(syncPrefix),
+        m_groupCount(groupCount),
+        m_ownGroup(getGroup(peerPrefix, groupCount)) {
+}
+
+uint32_t SyncGroups::getGroup(const ndn::Name &producer, uint32_t groupCount) {
+    if (groupCount <= 1) return 0;
+    // FNV-1a, so that every logger computes the same group
+    uint64_t hash = 14695981039346656037ULL;
+    for (auto byte: producer.wireEncode()) {
+        hash = (hash ^ byte) * 1099511628211ULL;
+    }
+    return hash % groupCount;
+}
+
+ndn::Name SyncGroups::getGroupPrefix(uint32_t group) const {
+    if (m_groupCount <= 1) return m_syncPrefix;
+    return ndn::Name(m_syncPrefix).appendNumber(group);
+}
+
+bool SyncGroups::isFetchedOnReference(const ndn::Name &recordName, uint64_t collectedSeqId) const {
+    if (m_groupCount <= 1) return false;
+    return getGroup(Record::getProducerPrefix(recordName)) != m_ownGroup &&
+           Record::getRecordSeqId(recordName) > collectedSeqId;
+}
+
+} // namespace mnemosyne::dag
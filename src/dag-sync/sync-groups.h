@@ -0,0 +1,48 @@
+#ifndef MNEMOSYNE_SYNC_GROUPS_H
+#define MNEMOSYNE_SYNC_GROUPS_H
+
+#include <ndn-cxx/name.hpp>
+#include <cstdint>
+
+namespace mnemosyne::dag {
+
+/**
+ * The partition of loggers into sync groups, by a hash of their names that every logger computes the same.
+ * With more than one group, each group synchronizes under <syncPrefix>/<group>, and a logger publishes only in its
+ * own group while listening to the others.
+ */
+class SyncGroups {
+  public:
+    SyncGroups(const ndn::Name &syncPrefix, const ndn::Name &peerPrefix, uint32_t groupCount);
+
+    /**
+     * @return the group of @p producer out of @p groupCount, 0 if there is at most one group
+     */
+    static uint32_t getGroup(const ndn::Name &producer, uint32_t groupCount);
+
+    uint32_t getGroup(const ndn::Name &producer) const {
+        return getGroup(producer, m_groupCount);
+    }
+
+    uint32_t getOwnGroup() const {
+        return m_ownGroup;
+    }
+
+    ndn::Name getGroupPrefix(uint32_t group) const;
+
+    /**
+     * @return whether the record @p recordName, referenced by a record received before it, is fetched at once
+     * rather than on the sync update of its group: it is in another group and past @p collectedSeqId, the
+     * version of its producer collected so far
+     */
+    bool isFetchedOnReference(const ndn::Name &recordName, uint64_t collectedSeqId) const;
+
+  private:
+    ndn::Name m_syncPrefix;
+    uint32_t m_groupCount;
+    uint32_t m_ownGroup;
+};
+
+} // namespace mnemosyne::dag
+
+#endif //MNEMOSYNE_SYNC_GROUPS_H
@@ -0,0 +1,92 @@
+#include "tailing-record-set.h"
+
+#include <algorithm>
+
+namespace mnemosyne::dag {
+
+TailingRecordSet::TailingRecordSet(uint32_t maxRefCount) :
+        m_buckets(std::max<uint32_t>(maxRefCount, 1) + 1) {
+}
+
+const Name &TailingRecordSet::getRecord(const Name &producer) const {
+    return m_tails.at(producer).recordName;
+}
+
+void TailingRecordSet::update(const Name &producer, const Name &recordFullName, uint32_t refCount) {
+    auto it = m_tails.find(producer);
+    if (it == m_tails.end()) {
+        it = m_tails.emplace(producer, Tail{recordFullName, refCount, 0}).first;
+    } else {
+        removeFromBucket(*it);
+        it->second.recordName = recordFullName;
+        it->second.refCount = refCount;
+    }
+    addToBucket(*it);
+}
+
+void TailingRecordSet::erase(const Name &producer) {
+    auto it = m_tails.find(producer);
+    if (it == m_tails.end()) return;
+    removeFromBucket(*it);
+    m_tails.erase(it);
+}
+
+void TailingRecordSet::selectInto(Record &record, size_t num, std::mt19937_64 &randomEngine) {
+    // find the lowest count such that tails with that count or higher are enough
+    size_t threshold = m_buckets.size();
+    size_t candidates = 0;
+    while (candidates < num && threshold > 0) {
+        threshold--;
+        candidates += m_buckets[threshold].size();
+    }
+    if (candidates < num) {
+        NDN_THROW(std::runtime_error("Not enough tailing records to select from"));
+    }
+
+    // sample the threshold bucket first: a consumed tail moves one bucket down,
+    // so it never lands in a bucket that is still to be visited
+    auto &bucket = m_buckets[threshold];
+    for (size_t i = candidates - bucket.size(); i < num; i++) {
+        std::uniform_int_distribution<size_t> distribution(0, bucket.size() - 1);
+        auto &entry = *bucket[distribution(randomEngine)];
+        record.addPointer(entry.second.recordName);
+        consume(entry);
+    }
+    for (size_t count = threshold + 1; count < m_buckets.size(); count++) {
+        while (!m_buckets[count].empty()) {
+            auto &entry = *m_buckets[count].back();
+            record.addPointer(entry.second.recordName);
+            consume(entry);
+        }
+    }
+}
+
+size_t TailingRecordSet::getBucketId(const Tail &tail) const {
+    return std::min<size_t>(tail.refCount, m_buckets.size() - 1);
+}
+
+void TailingRecordSet::addToBucket(Entry &entry) {
+    auto &bucket = m_buckets[getBucketId(entry.second)];
+    entry.second.position = bucket.size();
+    bucket.push_back(&entry);
+}
+
+void TailingRecordSet::removeFromBucket(Entry &entry) {
+    auto &bucket = m_buckets[getBucketId(entry.second)];
+    auto last = bucket.back();
+    bucket[entry.second.position] = last;
+    last->second.position = entry.second.position;
+    bucket.pop_back();
+}
+
+void TailingRecordSet::consume(Entry &entry) {
+    removeFromBucket(entry);
+    if (entry.second.refCount <= 1) {
+        m_tails.erase(m_tails.find(entry.first));
+        return;
+    }
+    entry.second.refCount--;
+    addToBucket(entry);
+}
+
+} // namespace mnemosyne::dag
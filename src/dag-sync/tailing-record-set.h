@@ -0,0 +1,64 @@
+#ifndef MNEMOSYNE_TAILING_RECORD_SET_H
+#define MNEMOSYNE_TAILING_RECORD_SET_H
+
+#include "mnemosyne/tip-selection-policy.hpp"
+#include <ndn-cxx/name.hpp>
+#include <ndn-cxx/util/exception.hpp>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+namespace mnemosyne::dag {
+
+/**
+ * The last record in each producer's chain that may still be referenced, with its remaining reference count.
+ * Tails are kept in buckets by remaining reference count, so that selecting k preceding records costs O(k).
+ * This is the "random" tip selection policy.
+ */
+class TailingRecordSet : public TipSelectionPolicy {
+  public:
+    explicit TailingRecordSet(uint32_t maxRefCount);
+
+    size_t size() const override {
+        return m_tails.size();
+    }
+
+    bool contains(const ndn::Name &producer) const override {
+        return m_tails.count(producer) != 0;
+    }
+
+    const ndn::Name &getRecord(const ndn::Name &producer) const override;
+
+    void update(const ndn::Name &producer, const ndn::Name &recordFullName, uint32_t refCount) override;
+
+    void erase(const ndn::Name &producer) override;
+
+    /**
+     * Tails with the highest remaining reference count are preferred, chosen uniformly at random within a count.
+     */
+    void selectInto(Record &record, size_t num, std::mt19937_64 &randomEngine) override;
+
+  private:
+    struct Tail {
+        ndn::Name recordName;
+        uint32_t refCount;
+        size_t position;
+    };
+    using Entry = std::pair<const ndn::Name, Tail>;
+
+    size_t getBucketId(const Tail &tail) const;
+
+    void addToBucket(Entry &entry);
+
+    void removeFromBucket(Entry &entry);
+
+    void consume(Entry &entry);
+
+  private:
+    std::unordered_map<ndn::Name, Tail> m_tails;
+    std::vector<std::vector<Entry *>> m_buckets;
+};
+
+} // namespace mnemosyne::dag
+
+#endif //MNEMOSYNE_TAILING_RECORD_SET_H
@@ -0,0 +1,51 @@
+#include "width-controller.h"
+
+#include <ndn-cxx/util/exception.hpp>
+#include <ndn-cxx/util/logger.hpp>
+#include <algorithm>
+
+NDN_LOG_INIT(mnemosyne.dagsync.widthController);
+
+namespace mnemosyne::dag {
+
+WidthController::WidthController(const LoggerConfig &config) :
+        m_adaptive(config.adaptiveWidth),
+        m_minPrecedingRecordNum(config.adaptiveWidth ? config.minPrecedingRecordNum : config.precedingRecordNum),
+        m_maxPrecedingRecordNum(config.adaptiveWidth ? config.maxPrecedingRecordNum : config.precedingRecordNum),
+        m_minSelfReRefCount(config.adaptiveWidth ? config.minSelfReRefCount : config.maxSelfReRefCount),
+        m_maxSelfReRefCount(config.adaptiveWidth ? config.maxAdaptiveSelfReRefCount : config.maxSelfReRefCount),
+        m_lowArrivalRate(config.lowArrivalRate),
+        m_highArrivalRate(config.highArrivalRate),
+        m_lagThreshold(config.widthReplicationLagThreshold),
+        m_adjustPeriod(config.widthAdjustPeriod),
+        m_arrivals(0),
+        m_lastAdjust(Clock::now()) {
+    if (m_minPrecedingRecordNum <= 1 || m_minPrecedingRecordNum > m_maxPrecedingRecordNum ||
+        m_minSelfReRefCount == 0 || m_minSelfReRefCount > m_maxSelfReRefCount) {
+        NDN_THROW(std::runtime_error("Bad width bounds"));
+    }
+    m_precedingRecordNum = std::clamp(config.precedingRecordNum, m_minPrecedingRecordNum, m_maxPrecedingRecordNum);
+    m_selfReRefCount = std::clamp(config.maxSelfReRefCount, m_minSelfReRefCount, m_maxSelfReRefCount);
+}
+
+void WidthController::adjust(uint64_t unreplicatedRecords, Clock::time_point now) {
+    if (!m_adaptive || now - m_lastAdjust < m_adjustPeriod) return;
+    auto rate = m_arrivals / std::chrono::duration<double>(now - m_lastAdjust).count();
+    m_arrivals = 0;
+    m_lastAdjust = now;
+
+    bool lagging = unreplicatedRecords > m_lagThreshold;
+    if (rate < m_lowArrivalRate || lagging) {
+        m_precedingRecordNum = std::min(m_precedingRecordNum + 1, m_maxPrecedingRecordNum);
+        m_selfReRefCount = std::min(m_selfReRefCount + 1, m_maxSelfReRefCount);
+    } else if (rate > m_highArrivalRate) {
+        m_precedingRecordNum = std::max(m_precedingRecordNum - 1, m_minPrecedingRecordNum);
+        m_selfReRefCount = std::max(m_selfReRefCount - 1, m_minSelfReRefCount);
+    } else {
+        return;
+    }
+    NDN_LOG_DEBUG("Arrival rate " << rate << "/s, " << unreplicatedRecords << " unreplicated records: width "
+                                  << m_precedingRecordNum << ", self re-reference " << m_selfReRefCount);
+}
+
+} // namespace mnemosyne::dag
@@ -0,0 +1,78 @@
+#ifndef MNEMOSYNE_WIDTH_CONTROLLER_H
+#define MNEMOSYNE_WIDTH_CONTROLLER_H
+
+#include "mnemosyne/logger-config.hpp"
+#include <chrono>
+
+namespace mnemosyne::dag {
+
+/**
+ * Choose the number of preceding records of a new record and the times a tail can be re-referenced by this logger,
+ * within the configured bounds.
+ * At each adjust period, both step up when few records arrive, as tails then go stale and replicate slowly, or when
+ * too many of this logger's records are not immutable yet; they step down when many records arrive and replication
+ * keeps up, which keeps headers small under load.
+ * Without adaptiveWidth, the configured precedingRecordNum and maxSelfReRefCount are used as is.
+ */
+class WidthController {
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit WidthController(const LoggerConfig &config);
+
+    size_t getPrecedingRecordNum() const {
+        return m_precedingRecordNum;
+    }
+
+    uint32_t getSelfReRefCount() const {
+        return m_selfReRefCount;
+    }
+
+    /**
+     * The bounds that received records are validated against.
+     */
+    size_t getMinPrecedingRecordNum() const {
+        return m_minPrecedingRecordNum;
+    }
+
+    size_t getMaxPrecedingRecordNum() const {
+        return m_maxPrecedingRecordNum;
+    }
+
+    uint32_t getMaxSelfReRefCount() const {
+        return m_maxSelfReRefCount;
+    }
+
+    /**
+     * Count a record accepted into the ledger.
+     */
+    void onRecordArrival() {
+        m_arrivals++;
+    }
+
+    /**
+     * Adjust the width if an adjust period has passed since the last adjustment.
+     * @p unreplicatedRecords, the number of this logger's records that are not immutable yet
+     */
+    void adjust(uint64_t unreplicatedRecords, Clock::time_point now = Clock::now());
+
+  private:
+    bool m_adaptive;
+    size_t m_minPrecedingRecordNum;
+    size_t m_maxPrecedingRecordNum;
+    uint32_t m_minSelfReRefCount;
+    uint32_t m_maxSelfReRefCount;
+    double m_lowArrivalRate;
+    double m_highArrivalRate;
+    uint64_t m_lagThreshold;
+    Clock::duration m_adjustPeriod;
+
+    size_t m_precedingRecordNum;
+    uint32_t m_selfReRefCount;
+    uint64_t m_arrivals;
+    Clock::time_point m_lastAdjust;
+};
+
+} // namespace mnemosyne::dag
+
+#endif //MNEMOSYNE_WIDTH_CONTROLLER_H
@@ -0,0 +1,63 @@
+#include "admission-queue.h"
+#include <algorithm>
+
+namespace mnemosyne::interface {
+
+AdmissionQueue::AdmissionQueue(size_t depth) :
+        m_depth(depth),
+        m_size(0),
+        m_dropped(0) {
+}
+
+bool AdmissionQueue::push(Event event, uint32_t weight) {
+    if (isFull()) {
+        auto heaviest = m_queues.end();
+        for (auto it = m_queues.begin(); it != m_queues.end(); it++) {
+            if (heaviest == m_queues.end() || isHeavier(it->second, heaviest->second)) heaviest = it;
+        }
+        auto own = m_queues.find(event.producer);
+        m_dropped++;
+        if (heaviest == m_queues.end() ||
+            (own != m_queues.end() && !isHeavier(heaviest->second, own->second))) {
+            return false;
+        }
+        heaviest->second.events.pop_back();
+        m_size--;
+        if (heaviest->second.events.empty()) {
+            // a producer has a turn only while it has events
+            m_turns.erase(std::find(m_turns.begin(), m_turns.end(), heaviest->first));
+            m_queues.erase(heaviest);
+        }
+    }
+
+    auto &queue = m_queues[event.producer];
+    if (queue.events.empty()) {
+        queue.weight = std::max<uint32_t>(weight, 1);
+        queue.served = 0;
+        m_turns.push_back(event.producer);
+    }
+    queue.events.push_back(std::move(event));
+    m_size++;
+    return true;
+}
+
+std::optional<AdmissionQueue::Event> AdmissionQueue::pop() {
+    if (m_turns.empty()) return std::nullopt;
+    auto it = m_queues.find(m_turns.front());
+    auto &queue = it->second;
+    auto event = std::move(queue.events.front());
+    queue.events.pop_front();
+    m_size--;
+    if (queue.events.empty()) {
+        m_queues.erase(it);
+        m_turns.pop_front();
+    } else if (++queue.served >= queue.weight) {
+        queue.served = 0;
+        auto producer = std::move(m_turns.front());
+        m_turns.pop_front();
+        m_turns.push_back(std::move(producer));
+    }
+    return event;
+}
+
+} // namespace mnemosyne::interface
@@ -0,0 +1,80 @@
+#ifndef MNEMOSYNE_ADMISSION_QUEUE_H
+#define MNEMOSYNE_ADMISSION_QUEUE_H
+
+#include <ndn-cxx/data.hpp>
+#include <ndn-cxx/name.hpp>
+#include <deque>
+#include <optional>
+#include <unordered_map>
+
+namespace mnemosyne::interface {
+
+/**
+ * Events received from the interfaces, waiting to be inserted into the DAG.
+ * Each client producer has its own FIFO, and the producers are served in turn, taking as many events per turn as
+ * their weight, so a producer flooding the queue only delays its own events.
+ * The queue holds up to a fixed number of events. Once full, an event takes the place of the newest event of the
+ * producer holding the most for its weight, and is refused if that is its own producer.
+ */
+class AdmissionQueue {
+  public:
+    struct Event {
+        ndn::Data data;
+        ndn::Name producer;
+    };
+
+    explicit AdmissionQueue(size_t depth);
+
+    /**
+     * @p weight the weight of the event's producer, taking effect when it has no other event queued
+     * @return false if the event is refused
+     */
+    bool push(Event event, uint32_t weight = 1);
+
+    /**
+     * @return the next event in producer turn order, nullopt if empty
+     */
+    std::optional<Event> pop();
+
+    size_t size() const {
+        return m_size;
+    }
+
+    bool isFull() const {
+        return m_size >= m_depth;
+    }
+
+    /**
+     * @return the number of events refused or evicted since construction
+     */
+    uint64_t getDroppedCount() const {
+        return m_dropped;
+    }
+
+  private:
+    struct ProducerQueue {
+        std::deque<Event> events;
+        uint32_t weight;
+        // events taken in the current turn
+        uint32_t served;
+    };
+
+    /**
+     * @return whether @p a holds more events than @p b for its weight
+     */
+    static bool isHeavier(const ProducerQueue &a, const ProducerQueue &b) {
+        return a.events.size() * b.weight > b.events.size() * a.weight;
+    }
+
+  private:
+    size_t m_depth;
+    size_t m_size;
+    uint64_t m_dropped;
+    std::unordered_map<ndn::Name, ProducerQueue> m_queues;
+    // producers with queued events, in the order of their next turn
+    std::deque<ndn::Name> m_turns;
+};
+
+} // namespace mnemosyne::interface
+
+#endif //MNEMOSYNE_ADMISSION_QUEUE_H
@@ -0,0 +1,51 @@
+#include "insertion-assignment.h"
+
+namespace mnemosyne::interface {
+
+InsertionAssignment::InsertionAssignment(ndn::Name self, std::chrono::seconds liveTimeout) :
+        m_self(std::move(self)),
+        m_liveTimeout(liveTimeout) {
+}
+
+void InsertionAssignment::onLoggerActive(const ndn::Name &logger, Clock::time_point now) {
+    if (logger == m_self) return;
+    m_lastActive[logger] = now;
+}
+
+void InsertionAssignment::onLoggersSynced(const std::set<ndn::Name> &loggers, Clock::time_point now) {
+    for (const auto &logger: loggers) {
+        onLoggerActive(logger, now);
+    }
+}
+
+size_t InsertionAssignment::getRank(const ndn::Name &key, Clock::time_point now) {
+    auto selfScore = getScore(m_self, key);
+    size_t rank = 0;
+    for (auto it = m_lastActive.begin(); it != m_lastActive.end();) {
+        if (now - it->second > m_liveTimeout) {
+            it = m_lastActive.erase(it);
+            continue;
+        }
+        auto score = getScore(it->first, key);
+        if (score > selfScore || (score == selfScore && it->first < m_self)) {
+            rank++;
+        }
+        it++;
+    }
+    return rank;
+}
+
+uint64_t InsertionAssignment::getScore(const ndn::Name &logger, const ndn::Name &key) {
+    // FNV-1a over both names, then a splitmix64 finalizer to spread similar names
+    uint64_t hash = 14695981039346656037ULL;
+    for (const auto *name: {&logger, &key}) {
+        for (auto byte: name->wireEncode()) {
+            hash = (hash ^ byte) * 1099511628211ULL;
+        }
+    }
+    hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    hash = (hash ^ (hash >> 27)) * 0x94d049bb133111ebULL;
+    return hash ^ (hash >> 31);
+}
+
+} // namespace mnemosyne::interface
@@ -0,0 +1,48 @@
+#ifndef MNEMOSYNE_INSERTION_ASSIGNMENT_H
+#define MNEMOSYNE_INSERTION_ASSIGNMENT_H
+
+#include <ndn-cxx/name.hpp>
+#include <chrono>
+#include <set>
+#include <unordered_map>
+
+namespace mnemosyne::interface {
+
+/**
+ * Assign the insertion of each event to the live loggers by rendezvous hashing, so that every logger agrees on
+ * the order in which loggers are responsible for an event without coordination.
+ * A logger is live if it was active within the timeout, that is published a record, announced one in a sync update,
+ * or appeared in the version vector of the DAG sync, which keeps loggers with no recent record live; this logger is
+ * always live.
+ * When loggers join or leave, only the events they rank first for move to another logger.
+ */
+class InsertionAssignment {
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    InsertionAssignment(ndn::Name self, std::chrono::seconds liveTimeout);
+
+    void onLoggerActive(const ndn::Name &logger, Clock::time_point now = Clock::now());
+
+    /**
+     * Mark every logger in the version vector of the DAG sync as active.
+     */
+    void onLoggersSynced(const std::set<ndn::Name> &loggers, Clock::time_point now = Clock::now());
+
+    /**
+     * @return the number of live loggers that rank before this logger for @p key; 0 if this logger is the primary
+     */
+    size_t getRank(const ndn::Name &key, Clock::time_point now = Clock::now());
+
+  private:
+    static uint64_t getScore(const ndn::Name &logger, const ndn::Name &key);
+
+  private:
+    ndn::Name m_self;
+    std::chrono::seconds m_liveTimeout;
+    std::unordered_map<ndn::Name, Clock::time_point> m_lastActive;
+};
+
+} // namespace mnemosyne::interface
+
+#endif //MNEMOSYNE_INSERTION_ASSIGNMENT_H
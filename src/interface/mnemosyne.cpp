@@ -1,5 +1,10 @@
 #include "mnemosyne/mnemosyne.hpp"
 #include "mnemosyne/backend.hpp"
+#include "dag-sync/checkpoint.h"
+#include "interface/admission-queue.h"
+#include "interface/insertion-assignment.h"
+#include "interface/producer-limiter.h"
+#include "interface/query-service.h"
 #include "interface/seen-event-set.h"
 #include "interface/self-inserted-set.h"
 #include "util.hpp"
@@ -7,6 +12,7 @@
 #include <ndn-cxx/util/logger.hpp>
 #include <ndn-cxx/util/logging.hpp>
 #include <ndn-cxx/security/signing-helpers.hpp>
+#include <sstream>
 #include <utility>
 
 NDN_LOG_INIT(mnemosyne.impl);
@@ -14,20 +20,43 @@ NDN_LOG_INIT(mnemosyne.impl);
 using namespace ndn;
 namespace mnemosyne {
 
+const std::string Mnemosyne::SEEN_EVENT_SEGMENT_KEY = "SeenEvents";
+const std::string Mnemosyne::SEEN_EVENT_INDEX_KEY = "SeenEventSegments";
+const size_t Mnemosyne::ADMISSION_BATCH_SIZE = 16;
+
 Mnemosyne::Mnemosyne(const Config &config, KeyChain &keychain, Face &network,
                      std::shared_ptr<ndn::security::Validator> recordValidator,
                      std::shared_ptr<ndn::security::Validator> eventValidator) :
-        m_randomEngine(std::random_device()()),
+        m_ready(false),
         m_config(config),
         m_keychain(keychain),
         m_scheduler(network.getIoService()),
+        m_randomEngine(std::random_device()()),
         m_eventValidator(std::move(eventValidator)),
-        m_seenEvents(std::make_unique<interface::SeenEventSet>(config.seenEventTtl)),
+        m_seenEvents(std::make_unique<interface::SeenEventSet>(config.seenEventTtl, config.seenEventMemoryLimit)),
+        m_seenEventsBackedUp(0),
+        m_firstSeenEventSegment(0),
         m_selfInsertEventProducers(std::make_unique<interface::SelfInsertedSet>(config.selfInsertResetFreq)),
-        m_ready(false),
+        m_producerLimiter(std::make_unique<interface::ProducerLimiter>(config.defaultProducerShare,
+                                                                       config.producerShares)),
+        m_admissionQueue(std::make_unique<interface::AdmissionQueue>(config.admissionQueueDepth)),
+        m_interfacesPaused(false),
         m_lastImmutableSeqNo(0),
         m_dagSync(m_config, keychain, network, std::move(recordValidator),
                   [this](const auto &record) { onRecordUpdate(record); }) {
+    if (config.insertionAssignment == "rendezvous") {
+        m_insertionAssignment = std::make_unique<interface::InsertionAssignment>(config.peerPrefix,
+                                                                                 config.liveLoggerTimeout);
+        m_dagSync.setOnSyncUpdateCallback([this](const Name &producer) {
+            m_insertionAssignment->onLoggerActive(producer);
+        });
+    } else if (config.insertionAssignment != "backoff") {
+        NDN_THROW(std::runtime_error("Unknown insertion assignment: " + config.insertionAssignment));
+    }
+    if (!config.queryPrefix.empty()) {
+        m_queryService = std::make_unique<interface::QueryService>(network, keychain, m_dagSync.getBackend(),
+                                                                   config.queryPrefix, config.peerPrefix);
+    }
     for (const auto &psName: config.svsPubSubInterfacePrefixes) {
         m_interfacePubSubs.emplace_back(psName, config.peerPrefix, network, [](const auto &i) {}, getSecurityOption());
     }
@@ -38,15 +67,25 @@ Mnemosyne::Mnemosyne(const Config &config, KeyChain &keychain, Face &network,
                                                                  getSecurityOption()));
     }
 
+    restoreSeenEvents();
+    scheduleSeenEventEviction();
+    scheduleSeenEventBackup();
+
     m_scheduler.schedule(time::nanoseconds(std::chrono::nanoseconds(config.startUpDelay).count()),
                          [this]() {
                              m_ready = true;
-                             for (auto &ps: m_interfacePubSubs) {
-                                 ps.subscribeToProducer(Name("/"), [this](const auto &d) { onSubscriptionData(d); });
-                             }
+                             subscribeInterfaces();
                          });
 }
 
+uint64_t Mnemosyne::getThrottledEventCount() const {
+    return m_producerLimiter->getThrottledCount();
+}
+
+uint64_t Mnemosyne::getDroppedEventCount() const {
+    return m_admissionQueue->getDroppedCount();
+}
+
 void Mnemosyne::onSubscriptionData(const svs::SVSPubSub::SubscriptionData &subData) {
     if (!subData.packet) {
         NDN_LOG_WARN("error");
@@ -55,10 +94,52 @@ void Mnemosyne::onSubscriptionData(const svs::SVSPubSub::SubscriptionData &subDa
     onEventData(*subData.packet, subData.producerPrefix);
 }
 
+void Mnemosyne::subscribeInterfaces() {
+    m_subscriptionHandles.clear();
+    for (auto &ps: m_interfacePubSubs) {
+        m_subscriptionHandles.push_back(
+                ps.subscribeToProducer(Name("/"), [this](const auto &d) { onSubscriptionData(d); }));
+    }
+    m_interfacesPaused = false;
+
+    // fetch the events announced on the sync groups while paused
+    auto missedSyncUpdates = std::move(m_missedSyncUpdates);
+    m_missedSyncUpdates.clear();
+    for (const auto &[groupId, ranges]: missedSyncUpdates) {
+        std::vector<ndn::svs::MissingDataInfo> info;
+        for (const auto &[nodeId, range]: ranges) {
+            info.push_back({nodeId, range.first, range.second});
+        }
+        onSyncUpdate(groupId, info);
+    }
+}
+
+void Mnemosyne::pauseInterfaces() {
+    // the events published on the pubsub interfaces meanwhile are left to the other loggers
+    auto ps = m_interfacePubSubs.begin();
+    for (auto handle: m_subscriptionHandles) {
+        (ps++)->unsubscribe(handle);
+    }
+    m_subscriptionHandles.clear();
+    m_interfacesPaused = true;
+}
+
 void Mnemosyne::onSyncUpdate(uint32_t groupId, const std::vector<ndn::svs::MissingDataInfo> &info) {
     if (!m_ready) {
         return;
     }
+    if (m_interfacesPaused) {
+        // the sync state moves on regardless, so the ranges are kept until resuming
+        auto &ranges = m_missedSyncUpdates[groupId];
+        for (const auto &s: info) {
+            auto range = ranges.try_emplace(s.nodeId, s.low, s.high);
+            if (!range.second) {
+                range.first->second.first = std::min(range.first->second.first, s.low);
+                range.first->second.second = std::max(range.first->second.second, s.high);
+            }
+        }
+        return;
+    }
     for (const auto &s: info) {
         for (ndn::svs::SeqNo i = s.low; i <= s.high; i++) {
             NDN_LOG_DEBUG("Interface Sync " << groupId << " Fetching item " << s.nodeId << " " << i);
@@ -77,34 +158,33 @@ void Mnemosyne::onSyncUpdate(uint32_t groupId, const std::vector<ndn::svs::Missi
 
 void Mnemosyne::onEventData(const Data &data, const ndn::Name& producer) {
     NDN_LOG_DEBUG("Received event data " << data.getFullName());
-    if (!m_seenEvents->hasEvent(data.getFullName())) {
-        onEventData(data, producer, m_config.insertionRetries);
+    if (m_seenEvents->hasEvent(data.getFullName())) {
+        return;
     }
-}
+    if (dag::Checkpoint::isCheckpointName(data.getName())) {
+        // only loggers issue checkpoints
+        NDN_LOG_WARN("Refused event data " << data.getFullName() << " named as a checkpoint");
+        return;
+    }
+    if (!m_producerLimiter->acquire(producer)) {
+        // no fast path for a producer beyond its rate
+        m_selfInsertEventProducers->erase(producer);
+        NDN_LOG_DEBUG("Throttled event data " << data.getFullName() << ", "
+                                              << m_producerLimiter->getThrottledCount(producer)
+                                              << " throttled from " << producer);
+        return;
+    }
+    auto eventInsert = [this, data, producer] { admitEvent(data, producer); };
 
-void Mnemosyne::onEventData(const Data &data, const ndn::Name& producer, uint32_t retries) {
-    auto eventInsert = [this, data, producer, retries]() {
-        if (m_seenEvents->hasEvent(data.getFullName())) {
-            NDN_LOG_DEBUG("Event data " << data.getFullName()
-                                        << " found in DAG. ");
-            return;
-        }
-        NDN_LOG_DEBUG("Event data " << data.getFullName()
-                                    << " not found in DAG. Publishing...");
-        Record record(data, producer);
-        auto ret = m_dagSync.createRecord(record);
-        if (ret.success()) {
-            m_selfInsertEventProducers->insert(producer);
-            NDN_LOG_INFO(m_config.peerPrefix << " Published event data " << data.getFullName()
-                                             << " in record " << Record::getRecordSeqId(record.getRecordFullName()));
+    if (m_insertionAssignment) {
+        auto rank = m_insertionAssignment->getRank(data.getName());
+        if (rank == 0) {
+            eventInsert();
         } else {
-            m_selfInsertEventProducers->erase(producer);
-            if (retries != 0) {
-                NDN_LOG_DEBUG("Retry insert event data " << data.getFullName());
-                onEventData(data, producer, retries - 1);
-            }
+            m_scheduler.schedule(time::milliseconds(rank * m_config.backupInsertDelay.count()), eventInsert);
         }
-    };
+        return;
+    }
 
     if (m_selfInsertEventProducers->count(producer)) {
         eventInsert();
@@ -115,6 +195,143 @@ void Mnemosyne::onEventData(const Data &data, const ndn::Name& producer, uint32_
     m_scheduler.schedule(time::milliseconds(delayDistribution(m_randomEngine)), eventInsert);
 }
 
+void Mnemosyne::admitEvent(const Data &data, const ndn::Name &producer) {
+    if (m_seenEvents->hasEvent(data.getFullName())) {
+        NDN_LOG_DEBUG("Event data " << data.getFullName() << " found in DAG. ");
+        return;
+    }
+    if (!m_admissionQueue->push({data, producer}, m_producerLimiter->getShare(producer).weight)) {
+        NDN_LOG_WARN("Admission queue full, refused event data " << data.getFullName() << ", "
+                                                                 << m_admissionQueue->getDroppedCount()
+                                                                 << " dropped so far");
+    }
+    if (m_admissionQueue->isFull() && !m_interfacesPaused) {
+        NDN_LOG_WARN(m_config.peerPrefix << " overloaded, pausing the interfaces");
+        pauseInterfaces();
+    }
+    drainAdmissionQueue();
+}
+
+void Mnemosyne::drainAdmissionQueue() {
+    std::vector<Record> records;
+    auto events = std::make_shared<std::vector<interface::AdmissionQueue::Event>>();
+    while (records.size() + m_dagSync.getPendingRecordCount() < ADMISSION_BATCH_SIZE) {
+        auto event = m_admissionQueue->pop();
+        if (!event) break;
+        // inserted by another logger while waiting
+        if (m_seenEvents->hasEvent(event->data.getFullName())) continue;
+        NDN_LOG_DEBUG("Event data " << event->data.getFullName() << " not found in DAG. Publishing...");
+        records.emplace_back(event->data, event->producer);
+        events->push_back(std::move(*event));
+    }
+    if (m_interfacesPaused && m_admissionQueue->size() <= m_config.admissionQueueDepth / 2) {
+        NDN_LOG_INFO(m_config.peerPrefix << " resuming the interfaces");
+        subscribeInterfaces();
+    }
+    if (records.empty()) return;
+
+    m_dagSync.createRecordsAsync(records, [this, events](size_t i, ReturnCode result) {
+        const auto &event = (*events)[i];
+        if (result.success()) {
+            // so that it is backed up with the others, and not inserted again after a restart
+            m_seenEvents->addEvent(event.data.getFullName());
+            m_selfInsertEventProducers->insert(event.producer);
+            NDN_LOG_INFO(m_config.peerPrefix << " Published event data " << event.data.getFullName()
+                                             << " in record " << Record::getRecordSeqId(Name(result.what())));
+        } else {
+            NDN_LOG_ERROR("Failed to publish event data " << event.data.getFullName() << ": " << result.what());
+        }
+        // more events may go once the DAG takes these
+        m_admissionDrainEvent = m_scheduler.schedule(time::milliseconds(0), [this] { drainAdmissionQueue(); });
+    });
+}
+
+void Mnemosyne::scheduleSeenEventEviction() {
+    m_seenEventEviction = m_scheduler.schedule(time::seconds(1), [this] {
+        m_seenEvents->evictExpired();
+        m_producerLimiter->evictIdle();
+        // a quiet logger still announces its version vector
+        if (m_insertionAssignment) m_insertionAssignment->onLoggersSynced(m_dagSync.getSyncedProducers());
+        scheduleSeenEventEviction();
+    });
+}
+
+void Mnemosyne::scheduleSeenEventBackup() {
+    if (m_config.seenEventBackupPeriod.count() == 0) return;
+    m_seenEventBackup = m_scheduler.schedule(time::seconds(m_config.seenEventBackupPeriod.count()), [this] {
+        backupSeenEvents();
+        scheduleSeenEventBackup();
+    });
+}
+
+std::string Mnemosyne::getSeenEventSegmentKey(uint64_t segment) const {
+    return SEEN_EVENT_SEGMENT_KEY + std::to_string(segment);
+}
+
+void Mnemosyne::backupSeenEvents() {
+    if (m_config.seenEventBackupPeriod.count() == 0) return;
+    auto backend = m_dagSync.getBackend();
+    // wall clock, as the expiries outlive the process in the index
+    auto now = std::chrono::system_clock::now();
+    auto firstSegment = m_firstSeenEventSegment;
+    while (!m_seenEventSegmentExpiry.empty() && m_seenEventSegmentExpiry.front() <= now) {
+        m_seenEventSegmentExpiry.pop_front();
+        m_firstSeenEventSegment++;
+    }
+
+    if (m_seenEvents->getAddedCount() != m_seenEventsBackedUp) {
+        const auto &wire = m_seenEvents->encode(m_seenEventsBackedUp);
+        auto segment = m_firstSeenEventSegment + m_seenEventSegmentExpiry.size();
+        if (!backend->placeMetaData(getSeenEventSegmentKey(segment),
+                                    std::string((const char *) wire.wire(), wire.size()))) {
+            NDN_LOG_ERROR("Failed to back up seen events");
+            return;
+        }
+        m_seenEventsBackedUp = m_seenEvents->getAddedCount();
+        m_seenEventSegmentExpiry.push_back(now + m_config.seenEventTtl);
+    }
+    // update the index before deleting, so that it never lists a deleted segment
+    std::ostringstream index;
+    index << m_firstSeenEventSegment << " " << m_firstSeenEventSegment + m_seenEventSegmentExpiry.size();
+    for (const auto &expiry: m_seenEventSegmentExpiry) {
+        index << " " << std::chrono::duration_cast<std::chrono::seconds>(expiry.time_since_epoch()).count();
+    }
+    backend->placeMetaData(SEEN_EVENT_INDEX_KEY, index.str());
+    for (auto segment = firstSegment; segment < m_firstSeenEventSegment; segment++) {
+        backend->deleteMetaData(getSeenEventSegmentKey(segment));
+    }
+}
+
+void Mnemosyne::restoreSeenEvents() {
+    auto backend = m_dagSync.getBackend();
+    auto index = backend->getMetaData(SEEN_EVENT_INDEX_KEY);
+    if (!index) return;
+    std::istringstream input(*index);
+    uint64_t first = 0, next = 0;
+    input >> first >> next;
+    auto now = std::chrono::system_clock::now();
+    m_firstSeenEventSegment = first;
+    for (auto segment = first; segment < next; segment++) {
+        // an index without expiries keeps the segments for a whole TTL
+        int64_t seconds;
+        auto expiry = input >> seconds ? std::chrono::system_clock::time_point(std::chrono::seconds(seconds))
+                                       : now + m_config.seenEventTtl;
+        // an expired segment stays listed until the next backup deletes it
+        m_seenEventSegmentExpiry.push_back(expiry);
+        if (expiry <= now) continue;
+        auto page = backend->getMetaData(getSeenEventSegmentKey(segment));
+        if (!page) continue;
+        try {
+            m_seenEvents->decode(Block(make_span(reinterpret_cast<const uint8_t *>(page->data()), page->size())));
+        }
+        catch (const std::exception &e) {
+            NDN_LOG_ERROR("Failed to restore seen event segment " << segment << ": " << e.what());
+        }
+    }
+    m_seenEventsBackedUp = m_seenEvents->getAddedCount();
+    NDN_LOG_INFO(m_config.peerPrefix << " restored " << m_seenEvents->size() << " seen events");
+}
+
 ndn::svs::SecurityOptions Mnemosyne::getSecurityOption() {
     ndn::svs::SecurityOptions option(m_keychain);
     option.validator = m_eventValidator ? make_shared<::util::cxxValidator>(m_eventValidator) : nullptr;
@@ -127,6 +344,18 @@ ndn::svs::SecurityOptions Mnemosyne::getSecurityOption() {
 }
 
 void Mnemosyne::onRecordUpdate(const Record &record) {
+    auto producer = Record::getProducerPrefix(record.getRecordFullName());
+    if (m_insertionAssignment) {
+        m_insertionAssignment->onLoggerActive(producer);
+    }
+    if (dag::Checkpoint::isCheckpointOf(record.getContentData().value().getName(), producer)) {
+        return;
+    }
+    if (producer == m_config.peerPrefix) {
+        // this logger's own record, restored from the backend; its event was validated when admitted
+        m_seenEvents->addEvent(record.getContentData().value().getFullName());
+        return;
+    }
     auto onValidated = [&](const Data &eventData) {
         const auto &eventFullName = eventData.getFullName();
         m_seenEvents->addEvent(eventFullName);
@@ -153,6 +382,8 @@ void Mnemosyne::onRecordUpdate(const Record &record) {
     }
 }
 
-Mnemosyne::~Mnemosyne() = default;
+Mnemosyne::~Mnemosyne() {
+    backupSeenEvents();
+}
 
 }  // namespace mnemosyne
\ No newline at end of file
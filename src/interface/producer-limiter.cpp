@@ -0,0 +1,63 @@
+#include "producer-limiter.h"
+#include <algorithm>
+
+namespace mnemosyne::interface {
+
+ProducerLimiter::ProducerLimiter(Config::ProducerShare defaultShare,
+                                 std::map<ndn::Name, Config::ProducerShare> shares) :
+        m_defaultShare(defaultShare),
+        m_shares(std::move(shares)),
+        m_throttled(0) {
+}
+
+const Config::ProducerShare &ProducerLimiter::getShare(const ndn::Name &producer) const {
+    if (m_shares.empty()) return m_defaultShare;
+    for (ssize_t length = producer.size(); length >= 0; length--) {
+        auto it = m_shares.find(producer.getPrefix(length));
+        if (it != m_shares.end()) return it->second;
+    }
+    return m_defaultShare;
+}
+
+bool ProducerLimiter::acquire(const ndn::Name &producer, Clock::time_point now) {
+    auto it = m_buckets.find(producer);
+    if (it == m_buckets.end()) {
+        const auto &share = getShare(producer);
+        if (share.rate <= 0) return true;
+        it = m_buckets.emplace(producer, Bucket{&share, share.burst, now, 0}).first;
+    }
+    auto &bucket = it->second;
+    refill(bucket, now);
+    if (bucket.tokens < 1) {
+        bucket.throttled++;
+        m_throttled++;
+        return false;
+    }
+    bucket.tokens -= 1;
+    return true;
+}
+
+void ProducerLimiter::evictIdle(Clock::time_point now) {
+    for (auto it = m_buckets.begin(); it != m_buckets.end();) {
+        refill(it->second, now);
+        if (it->second.tokens >= it->second.share->burst) {
+            it = m_buckets.erase(it);
+        } else {
+            it++;
+        }
+    }
+}
+
+uint64_t ProducerLimiter::getThrottledCount(const ndn::Name &producer) const {
+    auto it = m_buckets.find(producer);
+    return it == m_buckets.end() ? 0 : it->second.throttled;
+}
+
+void ProducerLimiter::refill(Bucket &bucket, Clock::time_point now) {
+    if (now <= bucket.updated) return;
+    std::chrono::duration<double> elapsed = now - bucket.updated;
+    bucket.tokens = std::min(bucket.share->burst, bucket.tokens + elapsed.count() * bucket.share->rate);
+    bucket.updated = now;
+}
+
+} // namespace mnemosyne::interface
@@ -0,0 +1,74 @@
+#ifndef MNEMOSYNE_PRODUCER_LIMITER_H
+#define MNEMOSYNE_PRODUCER_LIMITER_H
+
+#include "mnemosyne/config.hpp"
+#include <ndn-cxx/name.hpp>
+#include <chrono>
+#include <map>
+#include <unordered_map>
+
+namespace mnemosyne::interface {
+
+/**
+ * Token buckets limiting the rate of events taken from each client producer.
+ * The bucket of a producer holds up to burst tokens, refills at rate tokens per second, and each event takes a token.
+ * Buckets refilled to the full are forgotten, so only the recently active producers are kept.
+ */
+class ProducerLimiter {
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    ProducerLimiter(Config::ProducerShare defaultShare, std::map<ndn::Name, Config::ProducerShare> shares);
+
+    /**
+     * @return the share of the longest prefix of @p producer configured, or the default share
+     */
+    const Config::ProducerShare &getShare(const ndn::Name &producer) const;
+
+    /**
+     * Take a token for an event of @p producer.
+     * @return false, counting the event as throttled, if the producer is out of tokens
+     */
+    bool acquire(const ndn::Name &producer, Clock::time_point now = Clock::now());
+
+    /**
+     * Forget the buckets that are full by now.
+     */
+    void evictIdle(Clock::time_point now = Clock::now());
+
+    /**
+     * @return the number of events throttled since construction
+     */
+    uint64_t getThrottledCount() const {
+        return m_throttled;
+    }
+
+    /**
+     * @return the number of events of @p producer throttled since it was last forgotten
+     */
+    uint64_t getThrottledCount(const ndn::Name &producer) const;
+
+    size_t size() const {
+        return m_buckets.size();
+    }
+
+  private:
+    struct Bucket {
+        const Config::ProducerShare *share;
+        double tokens;
+        Clock::time_point updated;
+        uint64_t throttled;
+    };
+
+    static void refill(Bucket &bucket, Clock::time_point now);
+
+  private:
+    Config::ProducerShare m_defaultShare;
+    std::map<ndn::Name, Config::ProducerShare> m_shares;
+    std::unordered_map<ndn::Name, Bucket> m_buckets;
+    uint64_t m_throttled;
+};
+
+} // namespace mnemosyne::interface
+
+#endif //MNEMOSYNE_PRODUCER_LIMITER_H
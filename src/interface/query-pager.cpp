@@ -0,0 +1,197 @@
+#include "query-pager.h"
+#include "mnemosyne/record.hpp"
+
+#include <ndn-cxx/encoding/block-helpers.hpp>
+#include <ndn-cxx/util/logger.hpp>
+
+NDN_LOG_INIT(mnemosyne.interface.pager);
+
+namespace mnemosyne::interface {
+
+QueryPager::QueryPager(std::shared_ptr<const Backend> backend, const Name &queryPrefix) :
+        m_backend(std::move(backend)),
+        m_queryPrefix(queryPrefix) {
+}
+
+Name QueryPager::makeRecordQuery(const Name &queryPrefix, const Name &producer, uint64_t firstSeqId,
+                                 uint64_t lastSeqId) {
+    return Name(queryPrefix).append("RECORDS").append(encodeName(producer))
+            .appendNumber(firstSeqId).appendNumber(lastSeqId);
+}
+
+Name QueryPager::makeEventQuery(const Name &queryPrefix, const Name &eventPrefix, const std::optional<Name> &after) {
+    return Name(queryPrefix).append("EVENTS").append(encodeName(eventPrefix))
+            .append(after ? encodeName(*after) : name::Component());
+}
+
+Name QueryPager::makeTimeQuery(const Name &queryPrefix, const time::system_clock::time_point &from,
+                               const time::system_clock::time_point &to, const std::optional<Name> &after,
+                               const std::optional<Name> &eventPrefix) {
+    auto query = Name(queryPrefix).append("TIME")
+            .appendNumber(time::toUnixTimestamp(from).count()).appendNumber(time::toUnixTimestamp(to).count())
+            .append(after ? encodeName(*after) : name::Component());
+    if (eventPrefix) query.append(encodeName(*eventPrefix));
+    return query;
+}
+
+std::optional<Block> QueryPager::answer(const Name &query) const {
+    if (query.size() <= m_queryPrefix.size() || !m_queryPrefix.isPrefixOf(query)) return std::nullopt;
+    const auto &type = query.get(m_queryPrefix.size());
+    if (type == name::Component("RECORDS")) return answerRecordQuery(query);
+    if (type == name::Component("EVENTS")) return answerEventQuery(query);
+    if (type == name::Component("TIME")) return answerTimeQuery(query);
+    return std::nullopt;
+}
+
+std::list<Data> QueryPager::getPageRecords(const Block &content, std::optional<Name> &nextPage) {
+    std::list<Data> records;
+    nextPage = std::nullopt;
+    content.parse();
+    for (const auto &element: content.elements()) {
+        if (element.type() == T_NextPage) {
+            element.parse();
+            nextPage = Name(element.get(tlv::Name));
+        } else {
+            records.emplace_back(element);
+        }
+    }
+    return records;
+}
+
+std::optional<Block> QueryPager::answerRecordQuery(const Name &query) const {
+    auto offset = m_queryPrefix.size() + 1;
+    if (query.size() != offset + 3) return std::nullopt;
+    auto producer = decodeName(query.get(offset));
+    auto firstSeqId = query.get(offset + 1).toNumber();
+    auto lastSeqId = query.get(offset + 2).toNumber();
+    if (firstSeqId > lastSeqId) return std::nullopt;
+
+    auto page = makeEmptyBlock(tlv::Content);
+    auto seqId = firstSeqId;
+    bool complete = false;
+    while (seqId - firstSeqId < MAX_PAGE_SCAN) {
+        if (!addToPage(page, m_backend->listRecord(Record::getRecordName(producer, seqId)))) break;
+        if (seqId == lastSeqId) {
+            complete = true;
+            break;
+        }
+        seqId++;
+    }
+    if (!complete) {
+        auto next = makeEmptyBlock(T_NextPage);
+        next.push_back(makeRecordQuery(m_queryPrefix, producer, seqId, lastSeqId).wireEncode());
+        next.encode();
+        page.push_back(next);
+    }
+    page.encode();
+    return page;
+}
+
+std::optional<Block> QueryPager::answerEventQuery(const Name &query) const {
+    auto offset = m_queryPrefix.size() + 1;
+    if (query.size() != offset + 2) return std::nullopt;
+    auto eventPrefix = decodeName(query.get(offset));
+    std::optional<Name> after;
+    if (query.get(offset + 1).value_size() > 0) after = decodeName(query.get(offset + 1));
+
+    auto page = makeEmptyBlock(tlv::Content);
+    auto events = m_backend->listEvents(eventPrefix, after, MAX_PAGE_SCAN);
+    bool complete = events.size() < MAX_PAGE_SCAN;
+    for (const auto &event: events) {
+        if (!addToPage(page, m_backend->findRecordByEvent(event))) {
+            complete = false;
+            break;
+        }
+        after = event;
+    }
+    if (!complete) {
+        auto next = makeEmptyBlock(T_NextPage);
+        next.push_back(makeEventQuery(m_queryPrefix, eventPrefix, after).wireEncode());
+        next.encode();
+        page.push_back(next);
+    }
+    page.encode();
+    return page;
+}
+
+std::optional<Block> QueryPager::answerTimeQuery(const Name &query) const {
+    auto offset = m_queryPrefix.size() + 1;
+    if (query.size() != offset + 3 && query.size() != offset + 4) return std::nullopt;
+    auto from = time::fromUnixTimestamp(time::milliseconds(query.get(offset).toNumber()));
+    auto to = time::fromUnixTimestamp(time::milliseconds(query.get(offset + 1).toNumber()));
+    std::optional<Name> after;
+    if (query.get(offset + 2).value_size() > 0) after = decodeName(query.get(offset + 2));
+    std::optional<Name> eventPrefix;
+    if (query.size() == offset + 4) eventPrefix = decodeName(query.get(offset + 3));
+
+    auto page = makeEmptyBlock(tlv::Content);
+    // the records out of the event prefix count toward the scan, so that a page is bounded in the records read
+    auto records = m_backend->listRecordsByTime(from, to, MAX_PAGE_SCAN, after);
+    bool complete = records.size() < MAX_PAGE_SCAN;
+    for (const auto &record: records) {
+        if (eventPrefix && !carriesEventUnder(record, *eventPrefix)) {
+            after = record;
+            continue;
+        }
+        if (!addToPage(page, {record})) {
+            complete = false;
+            break;
+        }
+        after = record;
+    }
+    if (!complete) {
+        auto next = makeEmptyBlock(T_NextPage);
+        next.push_back(makeTimeQuery(m_queryPrefix, from, to, after, eventPrefix).wireEncode());
+        next.encode();
+        page.push_back(next);
+    }
+    page.encode();
+    return page;
+}
+
+bool QueryPager::addToPage(Block &page, const std::list<Name> &recordNames) const {
+    // the records of a sequence number or an event go into the same page, so that the next one starts clean
+    std::list<std::shared_ptr<const Data>> records;
+    size_t size = 0;
+    for (const auto &recordName: recordNames) {
+        auto record = m_backend->getRecord(recordName);
+        if (!record) continue;
+        size += record->wireEncode().size();
+        records.push_back(std::move(record));
+    }
+    size_t pageSize = 0;
+    for (const auto &element: page.elements()) pageSize += element.size();
+    if (!page.elements().empty() && pageSize + size > MAX_PAGE_SIZE) return false;
+    for (const auto &record: records) {
+        const auto &wire = record->wireEncode();
+        if (pageSize + wire.size() > MAX_CONTENT_SIZE) {
+            NDN_LOG_WARN("Record " << record->getFullName() << " left out of a page, as it does not fit");
+            continue;
+        }
+        page.push_back(wire);
+        pageSize += wire.size();
+    }
+    return true;
+}
+
+bool QueryPager::carriesEventUnder(const Name &recordName, const Name &eventPrefix) const {
+    auto recordData = m_backend->getRecord(recordName);
+    if (!recordData) return false;
+    try {
+        Record record(recordData);
+        return record.getContentData() && eventPrefix.isPrefixOf(record.getContentData()->getName());
+    } catch (const std::exception &e) {
+        return false;
+    }
+}
+
+name::Component QueryPager::encodeName(const Name &name) {
+    const auto &wire = name.wireEncode();
+    return name::Component(make_span(wire.wire(), wire.size()));
+}
+
+Name QueryPager::decodeName(const name::Component &component) {
+    return Name(Block(make_span(component.value(), component.value_size())));
+}
+
+} // namespace mnemosyne::interface
@@ -0,0 +1,87 @@
+#ifndef MNEMOSYNE_QUERY_PAGER_H
+#define MNEMOSYNE_QUERY_PAGER_H
+
+#include "mnemosyne/backend.hpp"
+#include <ndn-cxx/encoding/block.hpp>
+#include <ndn-cxx/name.hpp>
+#include <list>
+#include <memory>
+#include <optional>
+
+namespace mnemosyne::interface {
+
+/**
+ * The pages of the read queries of clients, answered from the storage indexes of a logger.
+ *
+ * A query is a page name, one of
+ *   <query-prefix>/RECORDS/<producer>/<first-seq>/<last-seq>: the records of a producer in a sequence number range
+ *   <query-prefix>/EVENTS/<event-prefix>/<after>: the records of the events under a prefix, after the event <after>
+ *   <query-prefix>/TIME/<from>/<to>/<after>[/<event-prefix>]: the records timed in [<from>, <to>) in milliseconds
+ *     since the epoch, after the record <after>, and only those carrying an event under <event-prefix> if given
+ * where <producer>, <event-prefix> and <after> are name components holding the wire encoding of a Name, and <after> is
+ * empty on the first page.
+ * The page carries the stored records as they were signed by their producers, followed by the name of the next page
+ * when the result is not complete. A page always fits a packet: the records of a sequence number or an event that do
+ * not fit an empty page are left out.
+ */
+class QueryPager {
+  public:
+    QueryPager(std::shared_ptr<const Backend> backend, const ndn::Name &queryPrefix);
+
+    static ndn::Name makeRecordQuery(const ndn::Name &queryPrefix, const ndn::Name &producer, uint64_t firstSeqId,
+                                     uint64_t lastSeqId);
+
+    static ndn::Name makeEventQuery(const ndn::Name &queryPrefix, const ndn::Name &eventPrefix,
+                                    const std::optional<ndn::Name> &after = std::nullopt);
+
+    static ndn::Name makeTimeQuery(const ndn::Name &queryPrefix, const ndn::time::system_clock::time_point &from,
+                                   const ndn::time::system_clock::time_point &to,
+                                   const std::optional<ndn::Name> &after = std::nullopt,
+                                   const std::optional<ndn::Name> &eventPrefix = std::nullopt);
+
+    /**
+     * @return the content of the page named @p query, nullopt if it is a bad query
+     * @throw std::exception if a component of @p query cannot be decoded
+     */
+    std::optional<ndn::Block> answer(const ndn::Name &query) const;
+
+    /**
+     * @return the records carried by the content of a page, and the name of the next page, if any
+     */
+    static std::list<ndn::Data> getPageRecords(const ndn::Block &content, std::optional<ndn::Name> &nextPage);
+
+  private:
+    std::optional<ndn::Block> answerRecordQuery(const ndn::Name &query) const;
+
+    std::optional<ndn::Block> answerEventQuery(const ndn::Name &query) const;
+
+    std::optional<ndn::Block> answerTimeQuery(const ndn::Name &query) const;
+
+    /**
+     * Add the stored records @p recordNames to the page, unless it is full. An empty page takes as many as fit.
+     * @return whether the records were added
+     */
+    bool addToPage(ndn::Block &page, const std::list<ndn::Name> &recordNames) const;
+
+    bool carriesEventUnder(const ndn::Name &recordName, const ndn::Name &eventPrefix) const;
+
+    static ndn::name::Component encodeName(const ndn::Name &name);
+
+    static ndn::Name decodeName(const ndn::name::Component &component);
+
+  private:
+    const static uint8_t T_NextPage = 170;
+    // content bytes of a page, past which it takes no more sequence numbers or events
+    const static size_t MAX_PAGE_SIZE = 4096;
+    // content bytes a page never exceeds, leaving room in a packet for the query name and the signature
+    const static size_t MAX_CONTENT_SIZE = 7000;
+    // sequence numbers looked up for a page, so that a sparse range does not stall the logger
+    const static uint64_t MAX_PAGE_SCAN = 256;
+
+    std::shared_ptr<const Backend> m_backend;
+    ndn::Name m_queryPrefix;
+};
+
+} // namespace mnemosyne::interface
+
+#endif //MNEMOSYNE_QUERY_PAGER_H
@@ -0,0 +1,59 @@
+#include "query-service.h"
+
+#include <ndn-cxx/security/signing-helpers.hpp>
+#include <ndn-cxx/util/logger.hpp>
+
+NDN_LOG_INIT(mnemosyne.interface.query);
+
+namespace mnemosyne::interface {
+
+const ndn::time::milliseconds QueryService::QUERY_CACHE_LIFETIME = ndn::time::seconds(1);
+
+QueryService::QueryService(Face &face, KeyChain &keychain, std::shared_ptr<Backend> backend,
+                           const Name &queryPrefix, const Name &signingIdentity) :
+        m_face(face),
+        m_keychain(keychain),
+        m_pager(std::move(backend), queryPrefix),
+        m_signingIdentity(signingIdentity),
+        m_cache(face.getIoService(), QUERY_CACHE_SIZE) {
+    m_queryPrefixHandle = m_face.setInterestFilter(queryPrefix,
+                                                   [this](auto &&, const auto &interest) {
+                                                       onQueryInterest(interest);
+                                                   },
+                                                   [](auto &&...) {
+                                                       NDN_LOG_ERROR("Query prefix registration failed");
+                                                   });
+}
+
+void QueryService::onQueryInterest(const Interest &interest) {
+    Interest lookup(interest.getName());
+    lookup.setMustBeFresh(true);
+    auto cached = m_cache.find(lookup);
+    try {
+        if (cached) {
+            m_face.put(*cached);
+            return;
+        }
+
+        std::optional<Block> content;
+        try {
+            content = m_pager.answer(interest.getName());
+        }
+        catch (const std::exception &e) {
+            NDN_LOG_DEBUG("Bad query " << interest.getName() << ": " << e.what());
+        }
+        if (!content) return;
+
+        Data response(interest.getName());
+        response.setContent(*content);
+        response.setFreshnessPeriod(QUERY_CACHE_LIFETIME);
+        m_keychain.sign(response, security::signingByIdentity(m_signingIdentity));
+        m_cache.insert(response, QUERY_CACHE_LIFETIME);
+        m_face.put(response);
+    }
+    catch (const std::exception &e) {
+        NDN_LOG_ERROR("Failed to answer query " << interest.getName() << ": " << e.what());
+    }
+}
+
+} // namespace mnemosyne::interface
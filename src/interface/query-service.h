@@ -0,0 +1,40 @@
+#ifndef MNEMOSYNE_QUERY_SERVICE_H
+#define MNEMOSYNE_QUERY_SERVICE_H
+
+#include "mnemosyne/backend.hpp"
+#include "query-pager.h"
+#include <ndn-cxx/face.hpp>
+#include <ndn-cxx/ims/in-memory-storage-lru.hpp>
+#include <ndn-cxx/security/key-chain.hpp>
+#include <memory>
+
+namespace mnemosyne::interface {
+
+/**
+ * Answer read queries of clients from the storage indexes of this logger, so that they need not join DAG sync.
+ * A query is a page Interest under the query prefix, named as built by QueryPager. Pages are cached for a short
+ * lifetime.
+ */
+class QueryService {
+  public:
+    QueryService(ndn::Face &face, ndn::KeyChain &keychain, std::shared_ptr<Backend> backend,
+                 const ndn::Name &queryPrefix, const ndn::Name &signingIdentity);
+
+  private:
+    void onQueryInterest(const ndn::Interest &interest);
+
+  private:
+    const static size_t QUERY_CACHE_SIZE = 256;
+    static const ndn::time::milliseconds QUERY_CACHE_LIFETIME;
+
+    ndn::Face &m_face;
+    ndn::KeyChain &m_keychain;
+    QueryPager m_pager;
+    ndn::Name m_signingIdentity;
+    ndn::InMemoryStorageLru m_cache;
+    ndn::ScopedRegisteredPrefixHandle m_queryPrefixHandle;
+};
+
+} // namespace mnemosyne::interface
+
+#endif //MNEMOSYNE_QUERY_SERVICE_H
@@ -3,39 +3,132 @@
 //
 
 #include "seen-event-set.h"
+#include <ndn-cxx/encoding/block-helpers.hpp>
 #include <ndn-cxx/util/logger.hpp>
 #include <ndn-cxx/util/logging.hpp>
+#include <ndn-cxx/util/sha256.hpp>
+#include <algorithm>
+#include <cstring>
+#include <limits>
 
 NDN_LOG_INIT(mnemosyne.interface.seenEventSet);
 
 const uint32_t mnemosyne::interface::SeenEventSet::SEEN_EVENT_TYPE = 161;
+const uint32_t mnemosyne::interface::SeenEventSet::T_EventDigest = 162;
+const uint32_t mnemosyne::interface::SeenEventSet::T_RemainingTtl = 163;
+const uint32_t mnemosyne::interface::SeenEventSet::T_EncodedTime = 164;
+const uint32_t mnemosyne::interface::SeenEventSet::EMPTY_SLOT = std::numeric_limits<uint32_t>::max();
+const size_t mnemosyne::interface::SeenEventSet::NOT_FOUND = std::numeric_limits<size_t>::max();
 
-mnemosyne::interface::SeenEventSet::SeenEventSet(std::chrono::seconds ttl)
-        : m_ttl(ttl) {
+mnemosyne::interface::SeenEventSet::SeenEventSet(std::chrono::seconds ttl, size_t memoryLimit)
+        : m_ttl(ttl),
+          m_head(0),
+          m_size(0),
+          m_added(0) {
+    // an entry costs itself and two slots
+    size_t capacity = std::max<size_t>(memoryLimit / (sizeof(Entry) + 2 * sizeof(uint32_t)), 1);
+    capacity = std::min<size_t>(capacity, EMPTY_SLOT / 2);
+    size_t slots = 1;
+    while (slots < 2 * capacity) slots <<= 1;
+    m_entries.resize(capacity);
+    m_slots.assign(slots, EMPTY_SLOT);
+}
+
+bool mnemosyne::interface::SeenEventSet::hasEvent(const ndn::Name &eventName, Clock::time_point now) const {
+    auto slot = findSlot(getDigest(eventName));
+    return slot != NOT_FOUND && m_entries[m_slots[slot]].expiry > now;
+}
+
+void mnemosyne::interface::SeenEventSet::addEvent(const ndn::Name &eventName, Clock::time_point now) {
+    evictExpired(now);
+    auto digest = getDigest(eventName);
+    if (findSlot(digest) != NOT_FOUND) return;
+    insert(digest, now + m_ttl);
+}
+
+void mnemosyne::interface::SeenEventSet::evictExpired(Clock::time_point now) {
+    while (m_size > 0 && m_entries[m_head].expiry <= now) {
+        evictOldest();
+    }
+}
+
+mnemosyne::interface::SeenEventSet::Digest
+mnemosyne::interface::SeenEventSet::getDigest(const ndn::Name &eventName) {
+    Digest digest;
+    if (!eventName.empty() && eventName.get(-1).isImplicitSha256Digest() &&
+        eventName.get(-1).value_size() == digest.size()) {
+        std::copy_n(eventName.get(-1).value(), digest.size(), digest.begin());
+        return digest;
+    }
+    ndn::util::Sha256 sha;
+    sha << eventName.wireEncode();
+    auto buffer = sha.computeDigest();
+    std::copy_n(buffer->begin(), digest.size(), digest.begin());
+    return digest;
+}
 
+size_t mnemosyne::interface::SeenEventSet::getHome(const Digest &digest) const {
+    // digests are uniformly distributed already
+    size_t h;
+    std::memcpy(&h, digest.data(), sizeof(h));
+    return h & (m_slots.size() - 1);
 }
 
-bool mnemosyne::interface::SeenEventSet::hasEvent(const ndn::Name &eventName) {
-    return m_events.count(eventName);
+size_t mnemosyne::interface::SeenEventSet::findSlot(const Digest &digest) const {
+    for (auto slot = getHome(digest); m_slots[slot] != EMPTY_SLOT; slot = (slot + 1) & (m_slots.size() - 1)) {
+        if (m_entries[m_slots[slot]].digest == digest) return slot;
+    }
+    return NOT_FOUND;
 }
 
-void mnemosyne::interface::SeenEventSet::addEvent(const ndn::Name &eventName) {
-    if (hasEvent(eventName)) return;
-    m_events.emplace(eventName);
-    m_locations.emplace(std::chrono::system_clock::now(), eventName);
-    auto del_time = std::chrono::system_clock::now() - m_ttl;
-    while (!m_locations.empty()) {
-        if (m_locations.front().first <= del_time) {
-            m_events.erase(m_locations.front().second);
-            m_locations.pop();
-        } else break;
+void mnemosyne::interface::SeenEventSet::insert(const Digest &digest, Clock::time_point expiry) {
+    if (m_size == m_entries.size()) {
+        NDN_LOG_DEBUG("Seen event set full, forgetting the oldest event early");
+        evictOldest();
     }
+    auto index = (m_head + m_size) % m_entries.size();
+    m_entries[index] = {digest, expiry};
+    m_size++;
+    m_added++;
+
+    auto slot = getHome(digest);
+    while (m_slots[slot] != EMPTY_SLOT) slot = (slot + 1) & (m_slots.size() - 1);
+    m_slots[slot] = index;
 }
 
-ndn::Block mnemosyne::interface::SeenEventSet::encode() const {
+void mnemosyne::interface::SeenEventSet::evictOldest() {
+    auto mask = m_slots.size() - 1;
+    auto hole = findSlot(m_entries[m_head].digest);
+    m_head = (m_head + 1) % m_entries.size();
+    m_size--;
+    if (hole == NOT_FOUND) return;
+
+    // backward shift deletion, keeping every entry reachable from its home slot
+    for (auto slot = (hole + 1) & mask; m_slots[slot] != EMPTY_SLOT; slot = (slot + 1) & mask) {
+        auto home = getHome(m_entries[m_slots[slot]].digest);
+        if (((slot - home) & mask) >= ((slot - hole) & mask)) {
+            m_slots[hole] = m_slots[slot];
+            hole = slot;
+        }
+    }
+    m_slots[hole] = EMPTY_SLOT;
+}
+
+ndn::Block mnemosyne::interface::SeenEventSet::encode(uint64_t from) const {
+    // oldest first, so that decoding keeps the expiry order
     ndn::Block b(SEEN_EVENT_TYPE);
-    for (const auto &i: m_events) {
-        b.push_back(i.wireEncode());
+    auto now = Clock::now();
+    b.push_back(ndn::makeNonNegativeIntegerBlock(
+            T_EncodedTime, std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::system_clock::now().time_since_epoch()).count()));
+    // the entries still remembered are the last m_size added
+    auto skip = from > m_added - m_size ? from - (m_added - m_size) : 0;
+    for (size_t i = skip; i < m_size; i++) {
+        const auto &entry = m_entries[(m_head + i) % m_entries.size()];
+        if (entry.expiry <= now) continue;
+        b.push_back(ndn::makeBinaryBlock(T_EventDigest, entry.digest));
+        b.push_back(ndn::makeNonNegativeIntegerBlock(
+                T_RemainingTtl, std::chrono::duration_cast<std::chrono::milliseconds>(entry.expiry - now).count()));
     }
     b.encode();
     return b;
@@ -44,7 +137,25 @@ ndn::Block mnemosyne::interface::SeenEventSet::encode() const {
 void mnemosyne::interface::SeenEventSet::decode(const ndn::Block &b) {
     if (b.type() != SEEN_EVENT_TYPE) NDN_THROW(std::runtime_error("Bad block to decode"));
     b.parse();
-    for (const auto &i: b.elements()) {
-        addEvent(ndn::Name(i));
+    auto now = Clock::now();
+    const auto &elements = b.elements();
+    if (elements.empty() || elements[0].type() != T_EncodedTime) {
+        NDN_THROW(std::runtime_error("Bad seen event set"));
+    }
+    int64_t elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count() -
+                      ndn::readNonNegativeInteger(elements[0]);
+    auto ttl = std::chrono::duration_cast<std::chrono::milliseconds>(m_ttl).count();
+    for (size_t i = 1; i + 1 < elements.size(); i += 2) {
+        Digest digest;
+        if (elements[i].type() != T_EventDigest || elements[i + 1].type() != T_RemainingTtl ||
+            elements[i].value_size() != digest.size()) {
+            NDN_THROW(std::runtime_error("Bad seen event"));
+        }
+        std::copy_n(elements[i].value(), digest.size(), digest.begin());
+        auto remaining = std::min<int64_t>(ndn::readNonNegativeInteger(elements[i + 1]), ttl) -
+                         std::max<int64_t>(elapsed, 0);
+        if (remaining <= 0 || findSlot(digest) != NOT_FOUND) continue;
+        insert(digest, now + std::chrono::milliseconds(remaining));
     }
 }
@@ -6,31 +6,92 @@
 #define MNEMOSYNE_SEEN_EVENT_SET_H
 
 #include <ndn-cxx/name.hpp>
-#include <set>
-#include <queue>
+#include <array>
 #include <chrono>
+#include <vector>
 
 namespace mnemosyne::interface {
 
+/**
+ * The events recently seen in the DAG, forgotten after a TTL.
+ * Events are kept as 32-byte digests in an open-addressing hash table whose slots index a ring of entries.
+ * As every event has the same TTL, the ring is in expiry order and acts as the timing wheel: expired entries are
+ * at its head. The ring has a fixed capacity derived from the memory limit; once full, the oldest events are
+ * forgotten early.
+ */
 class SeenEventSet {
   public:
-    SeenEventSet(std::chrono::seconds ttl);
+    using Clock = std::chrono::steady_clock;
 
-    bool hasEvent(const ndn::Name &eventName);
+    SeenEventSet(std::chrono::seconds ttl, size_t memoryLimit);
 
-    void addEvent(const ndn::Name &eventName);
+    bool hasEvent(const ndn::Name &eventName, Clock::time_point now = Clock::now()) const;
 
-    ndn::Block encode() const;
+    void addEvent(const ndn::Name &eventName, Clock::time_point now = Clock::now());
 
+    /**
+     * Forget the events whose TTL has passed.
+     */
+    void evictExpired(Clock::time_point now = Clock::now());
+
+    size_t size() const {
+        return m_size;
+    }
+
+    /**
+     * @return the number of events added so far, counting from construction
+     */
+    uint64_t getAddedCount() const {
+        return m_added;
+    }
+
+    /**
+     * Encode the events still remembered, from the @p from-th one added, with their remaining TTL.
+     * Encoding from the previous getAddedCount() gives the events added since then.
+     */
+    ndn::Block encode(uint64_t from = 0) const;
+
+    /**
+     * Add the encoded events, deducting the wall clock time passed since they were encoded from their TTL.
+     */
     void decode(const ndn::Block &b);
 
   private:
-    std::queue<std::pair<std::chrono::time_point<std::chrono::system_clock>, ndn::Name>> m_locations;
-    std::set<ndn::Name> m_events;
-    ndn::Name m_peerPrefix;
-    std::chrono::seconds m_ttl;
+    using Digest = std::array<uint8_t, 32>;
+
+    struct Entry {
+        Digest digest;
+        Clock::time_point expiry;
+    };
+
+    static Digest getDigest(const ndn::Name &eventName);
 
+    size_t getHome(const Digest &digest) const;
+
+    /**
+     * @return the slot holding @p digest, or NOT_FOUND
+     */
+    size_t findSlot(const Digest &digest) const;
+
+    void insert(const Digest &digest, Clock::time_point expiry);
+
+    void evictOldest();
+
+  private:
     static const uint32_t SEEN_EVENT_TYPE;
+    static const uint32_t T_EventDigest;
+    static const uint32_t T_RemainingTtl;
+    static const uint32_t T_EncodedTime;
+    static const uint32_t EMPTY_SLOT;
+    static const size_t NOT_FOUND;
+
+    std::chrono::seconds m_ttl;
+    std::vector<Entry> m_entries;
+    size_t m_head;
+    size_t m_size;
+    uint64_t m_added;
+    // indexes into m_entries, with linear probing; at most half full
+    std::vector<uint32_t> m_slots;
 };
 
 }
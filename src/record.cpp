@@ -160,9 +160,18 @@ Record::bodyWireDecode(const Block &dataContent) {
 
 void
 Record::checkPointerCount(uint32_t numPointers) const {
-    if (getPointersFromHeader().size() < numPointers) {
+    checkPointerCount(numPointers, numPointers);
+}
+
+void
+Record::checkPointerCount(uint32_t minPointers, uint32_t maxPointers) const {
+    auto numPointers = getPointersFromHeader().size();
+    if (numPointers < minPointers) {
         throw std::runtime_error("Less preceding record than expected");
     }
+    if (numPointers > maxPointers) {
+        throw std::runtime_error("More preceding record than expected");
+    }
 
     std::set < Name > nameSet;
     for (const auto &pointer: getPointersFromHeader()) {
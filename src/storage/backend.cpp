@@ -3,10 +3,36 @@
 //
 
 #include "mnemosyne/backend.hpp"
+#include "mnemosyne/record.hpp"
 #include "storage/storage-leveldb.h"
+#include <algorithm>
+#include <iomanip>
 #include <iostream>
+#include <sstream>
 
 
+namespace {
+
+const std::string TIME_INDEX_KEY = "TimeIndex";
+
+// event index entries are a concatenation of Name TLVs
+std::list<ndn::Name> decodeNames(const std::string &value, const ndn::Name &recordName) {
+    std::list<ndn::Name> ans;
+    auto buffer = ndn::make_span(reinterpret_cast<const uint8_t *>(value.data()), value.size());
+    try {
+        while (!buffer.empty()) {
+            ndn::Block block(buffer);
+            ans.emplace_back(block);
+            buffer = buffer.subspan(block.size());
+        }
+    } catch (const std::exception &e) {
+        std::cerr << "Backend: bad index entry for " << recordName << ": " << e.what() << "\n";
+    }
+    return ans;
+}
+
+} // namespace
+
 mnemosyne::Backend::Backend(const LoggerConfig &config)
         : Backend(config.databaseType, config.databasePath, config.seqNoBackupFreq) {}
 
@@ -20,15 +46,38 @@ mnemosyne::Backend::Backend(const std::string &storage_type, const std::string &
     }
 }
 
+mnemosyne::Backend::Backend(std::shared_ptr<storage::Storage> storage) :
+        m_storage(std::move(storage)),
+        m_seqNoBackupFreq(1),
+        m_lastSeqNoBackup(1) {
+}
+
 shared_ptr<const Data> mnemosyne::Backend::getRecord(const Name &recordName) const {
     return m_storage->getRecord(recordName);
 }
 
 bool mnemosyne::Backend::putRecord(const shared_ptr<const Data> &recordData) {
-    return m_storage->putRecord(recordData);
+    if (!m_storage->putRecord(recordData)) return false;
+    auto eventName = getEventName(*recordData);
+    if (eventName) {
+        addIndexedName(getEventIndexKey(*eventName), recordData->getFullName());
+    }
+    if (Record::isRecordName(recordData->getName())) {
+        addTimeIndex(*recordData);
+    }
+    return true;
 }
 
 void mnemosyne::Backend::deleteRecord(const Name &recordName) {
+    auto recordData = m_storage->getRecord(recordName);
+    auto eventName = recordData ? getEventName(*recordData) : std::nullopt;
+    if (eventName) {
+        removeIndexedName(getEventIndexKey(*eventName), recordData->getFullName());
+    }
+    if (recordData) {
+        removeReverseReferences(*recordData);
+    }
+    removeTimeIndex(recordName);
     m_storage->deleteRecord(recordName);
 }
 
@@ -44,6 +93,201 @@ std::optional<std::string> mnemosyne::Backend::getMetaData(const std::string &ke
     return m_storage->getMetaData(key);
 }
 
+void mnemosyne::Backend::deleteMetaData(const std::string &key) {
+    m_storage->deleteMetaData(key);
+}
+
+std::list<std::string>
+mnemosyne::Backend::listMetaData(const std::string &prefix, const std::string &startAfter, uint32_t count) const {
+    return m_storage->listMetaData(prefix, startAfter, count);
+}
+
+void mnemosyne::Backend::addReferencingRecord(const Name &recordName, const Name &referencingRecord) {
+    if (!placeMetaData(getReverseReferenceKey(recordName, referencingRecord), "")) {
+        std::cerr << "Backend: reverse reference write failed for " << recordName << "\n";
+    }
+}
+
+std::list<Name> mnemosyne::Backend::getReferencingRecords(const Name &recordName) const {
+    auto keyPrefix = getReverseReferenceKey(recordName, Name());
+    std::list<Name> names;
+    for (const auto &key: listMetaData(keyPrefix)) {
+        names.emplace_back(key.substr(keyPrefix.size()));
+    }
+    return names;
+}
+
+std::list<Name> mnemosyne::Backend::findRecordByEvent(const Name &eventName) const {
+    auto value = getMetaData(getEventIndexKey(eventName));
+    if (!value) return {};
+    return decodeNames(*value, eventName);
+}
+
+std::list<Name>
+mnemosyne::Backend::listEvents(const Name &prefix, const std::optional<Name> &startAfter, uint32_t count) const {
+    // the key prefix also matches names whose last component merely starts like the one of @p prefix
+    auto keyPrefix = getEventIndexKey(prefix);
+    auto offset = getEventIndexKey(Name()).size() - 1;
+    auto after = startAfter ? getEventIndexKey(*startAfter) : "";
+    std::list<Name> events;
+    while (count == 0 || events.size() < count) {
+        auto keys = listMetaData(keyPrefix, after, count == 0 ? 0 : count - events.size());
+        if (keys.empty()) break;
+        for (const auto &key: keys) {
+            Name eventName(key.substr(offset));
+            if (prefix.isPrefixOf(eventName)) events.push_back(std::move(eventName));
+        }
+        after = keys.back();
+        if (count == 0) break;
+    }
+    return events;
+}
+
+std::list<Name>
+mnemosyne::Backend::listRecordsByTime(const time::system_clock::time_point &from,
+                                      const time::system_clock::time_point &to,
+                                      uint32_t limit, const std::optional<Name> &startAfter) const {
+    std::list<Name> names;
+    if (to <= from) return names;
+    uint64_t fromTimestamp = std::max<int64_t>(time::toUnixTimestamp(from).count(), 0);
+    uint64_t toTimestamp = std::max<int64_t>(time::toUnixTimestamp(to).count(), 0);
+    // keys at @p from sort right after the bare time
+    auto after = getTimeIndexKey(fromTimestamp, Name());
+    if (startAfter) {
+        auto startTime = getMetaData(getRecordTimeKey(*startAfter));
+        if (startTime && std::stoull(*startTime) >= fromTimestamp) {
+            after = getTimeIndexKey(std::stoull(*startTime), *startAfter);
+        }
+    }
+    // scan in batches, so that only the keys up to @p to are read
+    const uint32_t batchSize = 256;
+    while (limit == 0 || names.size() < limit) {
+        auto count = limit == 0 ? batchSize : std::min<uint32_t>(batchSize, limit - names.size());
+        auto keys = listMetaData(TIME_INDEX_KEY, after, count);
+        for (const auto &key: keys) {
+            if (std::stoull(key.substr(TIME_INDEX_KEY.size(), 16), nullptr, 16) >= toTimestamp) return names;
+            names.emplace_back(key.substr(TIME_INDEX_KEY.size() + 16));
+        }
+        if (keys.size() < count) break;
+        after = keys.back();
+    }
+    return names;
+}
+
+std::string mnemosyne::Backend::getReverseReferenceKey(const Name &recordName, const Name &referencingRecord) {
+    // a space never appears in a canonical URI, so the key prefix of a record matches no other record
+    auto key = "ReverseRef" + recordName.toUri(name::UriFormat::CANONICAL) + " ";
+    if (!referencingRecord.empty()) key += referencingRecord.toUri(name::UriFormat::CANONICAL);
+    return key;
+}
+
+std::string mnemosyne::Backend::getEventIndexKey(const Name &eventName) {
+    return "EventIndex" + eventName.toUri(name::UriFormat::CANONICAL);
+}
+
+std::string mnemosyne::Backend::getRecordTimeKey(const Name &recordName) {
+    return "RecordTime" + recordName.toUri(name::UriFormat::CANONICAL);
+}
+
+std::string mnemosyne::Backend::getTimeIndexKey(uint64_t timestamp, const Name &recordName) {
+    std::ostringstream os;
+    os << TIME_INDEX_KEY << std::hex << std::setw(16) << std::setfill('0') << timestamp;
+    if (!recordName.empty()) os << recordName.toUri(name::UriFormat::CANONICAL);
+    return os.str();
+}
+
+void mnemosyne::Backend::addTimeIndex(const Data &recordData) {
+    const auto &recordName = recordData.getFullName();
+    auto timeKey = getRecordTimeKey(recordName);
+    // stored again on restore or re-fetch, keeping the first time and repairing its index entry
+    auto storedTime = getMetaData(timeKey);
+    if (storedTime) {
+        auto indexKey = getTimeIndexKey(std::stoull(*storedTime), recordName);
+        if (!getMetaData(indexKey) && !placeMetaData(indexKey, "")) {
+            std::cerr << "Backend: time index write failed for " << recordName << "\n";
+        }
+        return;
+    }
+    auto time = recordData.getSignatureInfo().getTime().value_or(time::system_clock::now());
+    uint64_t timestamp = std::max<int64_t>(time::toUnixTimestamp(time).count(), 0);
+    // the index entry first, so that a record whose time is kept is always indexed
+    if (!placeMetaData(getTimeIndexKey(timestamp, recordName), "") ||
+        !placeMetaData(timeKey, std::to_string(timestamp))) {
+        std::cerr << "Backend: time index write failed for " << recordName << "\n";
+    }
+}
+
+void mnemosyne::Backend::removeReverseReferences(const Data &recordData) {
+    const auto &recordName = recordData.getFullName();
+    for (const auto &key: listMetaData(getReverseReferenceKey(recordName, Name()))) {
+        deleteMetaData(key);
+    }
+    if (!Record::isRecordName(recordData.getName()) || Record::isGenesisRecord(recordData.getName())) return;
+    try {
+        Record record(recordData);
+        for (const auto &pointer: record.getPointersFromHeader()) {
+            deleteMetaData(getReverseReferenceKey(pointer, recordName));
+        }
+    } catch (const std::exception &e) {
+        std::cerr << "Backend: cannot remove the references of " << recordData.getName() << ": " << e.what() << "\n";
+    }
+}
+
+void mnemosyne::Backend::removeTimeIndex(const Name &recordName) {
+    auto timeKey = getRecordTimeKey(recordName);
+    auto time = getMetaData(timeKey);
+    if (!time) return;
+    deleteMetaData(getTimeIndexKey(std::stoull(*time), recordName));
+    deleteMetaData(timeKey);
+}
+
+std::optional<Name> mnemosyne::Backend::getEventName(const Data &recordData) {
+    if (!Record::isRecordName(recordData.getName()) || Record::isGenesisRecord(recordData.getName())) {
+        return std::nullopt;
+    }
+    try {
+        Record record(recordData);
+        if (!record.getContentData()) return std::nullopt;
+        return record.getContentData()->getFullName();
+    } catch (const std::exception &e) {
+        std::cerr << "Backend: cannot index the event of " << recordData.getName() << ": " << e.what() << "\n";
+        return std::nullopt;
+    }
+}
+
+void mnemosyne::Backend::addIndexedName(const std::string &key, const Name &name) {
+    auto value = getMetaData(key).value_or("");
+    auto names = decodeNames(value, name);
+    if (std::find(names.begin(), names.end(), name) != names.end()) return;
+
+    const auto &wire = name.wireEncode();
+    value.append((const char *) wire.wire(), wire.size());
+    if (!placeMetaData(key, value)) {
+        std::cerr << "Backend: index write failed for " << key << "\n";
+    }
+}
+
+void mnemosyne::Backend::removeIndexedName(const std::string &key, const Name &name) {
+    auto value = getMetaData(key);
+    if (!value) return;
+    std::string remaining;
+    for (const auto &indexed: decodeNames(*value, name)) {
+        if (indexed == name) continue;
+        const auto &wire = indexed.wireEncode();
+        remaining.append((const char *) wire.wire(), wire.size());
+    }
+    if (remaining.empty()) {
+        deleteMetaData(key);
+    } else {
+        placeMetaData(key, remaining);
+    }
+}
+
+std::shared_ptr<const mnemosyne::Backend> mnemosyne::Backend::snapshot() const {
+    // the returned backend is const, so the read-only storage is never written through it
+    return std::shared_ptr<const Backend>(new Backend(std::const_pointer_cast<storage::Storage>(m_storage->snapshot())));
+}
+
 void mnemosyne::Backend::triggerBackup() {
     m_lastSeqNoBackup++;
     if (m_lastSeqNoBackup >= m_seqNoBackupFreq) { // backup
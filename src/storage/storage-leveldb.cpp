@@ -23,10 +23,15 @@ StorageLevelDb::~StorageLevelDb() {
 
 std::shared_ptr<const ndn::Data>
 StorageLevelDb::getRecord(const Name &recordName) const {
+    return getRecord(recordName, leveldb::ReadOptions());
+}
+
+std::shared_ptr<const ndn::Data>
+StorageLevelDb::getRecord(const Name &recordName, const leveldb::ReadOptions &options) const {
     const auto &nameStr = recordName.toUri(name::UriFormat::CANONICAL);
     leveldb::Slice key = nameStr;
     std::string value;
-    leveldb::Status s = m_db->Get(leveldb::ReadOptions(), key, &value);
+    leveldb::Status s = m_db->Get(options, key, &value);
     if (!s.ok()) {
         return nullptr;
     } else {
@@ -61,8 +66,13 @@ StorageLevelDb::deleteRecord(const Name &recordName) {
 
 std::list<Name>
 StorageLevelDb::listRecord(const Name &prefix, uint32_t count) const {
+    return listRecord(prefix, count, leveldb::ReadOptions());
+}
+
+std::list<Name>
+StorageLevelDb::listRecord(const Name &prefix, uint32_t count, const leveldb::ReadOptions &options) const {
     std::list<Name> names;
-    leveldb::Iterator *it = m_db->NewIterator(leveldb::ReadOptions());
+    leveldb::Iterator *it = m_db->NewIterator(options);
     for (it->Seek(prefix.toUri(name::UriFormat::CANONICAL)); it->Valid() &&
                                                              prefix.isPrefixOf(Name(it->key().ToString())) &&
                                                              (count == 0 || names.size() < count); it->Next()) {
@@ -86,10 +96,15 @@ bool StorageLevelDb::placeMetaData(std::string k, const std::string &v) {
 }
 
 std::optional<std::string> StorageLevelDb::getMetaData(const std::string &k) const {
+    return getMetaData(k, leveldb::ReadOptions());
+}
+
+std::optional<std::string>
+StorageLevelDb::getMetaData(const std::string &k, const leveldb::ReadOptions &options) const {
     if (k.empty() || k[0] == RECORD_PREFIX_CHAR) return std::nullopt;
     leveldb::Slice key = k;
     std::string value;
-    leveldb::Status s = m_db->Get(leveldb::ReadOptions(), key, &value);
+    leveldb::Status s = m_db->Get(options, key, &value);
     if (!s.ok()) {
         return std::nullopt;
     } else {
@@ -97,4 +112,79 @@ std::optional<std::string> StorageLevelDb::getMetaData(const std::string &k) con
     }
 }
 
+void StorageLevelDb::deleteMetaData(const std::string &k) {
+    if (k.empty() || k[0] == RECORD_PREFIX_CHAR) return;
+    leveldb::Slice key = k;
+    leveldb::Status s = m_db->Delete(leveldb::WriteOptions(), key);
+    if (!s.ok()) {
+        std::cerr << "Unable to delete metadata from database, key: " << k << std::endl;
+        std::cerr << s.ToString() << std::endl;
+    }
+}
+
+std::list<std::string>
+StorageLevelDb::listMetaData(const std::string &prefix, const std::string &startAfter, uint32_t count) const {
+    return listMetaData(prefix, startAfter, count, leveldb::ReadOptions());
+}
+
+std::list<std::string>
+StorageLevelDb::listMetaData(const std::string &prefix, const std::string &startAfter, uint32_t count,
+                             const leveldb::ReadOptions &options) const {
+    std::list<std::string> keys;
+    if (!prefix.empty() && prefix[0] == RECORD_PREFIX_CHAR) return keys;
+    leveldb::Iterator *it = m_db->NewIterator(options);
+    it->Seek(startAfter < prefix ? prefix : startAfter);
+    for (; it->Valid() && it->key().starts_with(prefix) && (count == 0 || keys.size() < count); it->Next()) {
+        auto key = it->key().ToString();
+        // an empty prefix also covers the record keys
+        if (key == startAfter || key.empty() || key[0] == RECORD_PREFIX_CHAR) continue;
+        keys.push_back(std::move(key));
+    }
+    assert(it->status().ok());
+    delete it;
+    return keys;
+}
+
+/**
+ * Reads of the storage pinned to a LevelDB snapshot, which is released with the last reference.
+ */
+class StorageLevelDbSnapshot : public StorageSnapshot {
+  public:
+    explicit StorageLevelDbSnapshot(std::shared_ptr<const StorageLevelDb> storage) :
+            m_storage(std::move(storage)),
+            m_snapshot(m_storage->m_db->GetSnapshot()) {
+        m_options.snapshot = m_snapshot;
+    }
+
+    ~StorageLevelDbSnapshot() override {
+        m_storage->m_db->ReleaseSnapshot(m_snapshot);
+    }
+
+    std::shared_ptr<const ndn::Data> getRecord(const Name &recordName) const override {
+        return m_storage->getRecord(recordName, m_options);
+    }
+
+    std::list<Name> listRecord(const Name &prefix, uint32_t count) const override {
+        return m_storage->listRecord(prefix, count, m_options);
+    }
+
+    std::optional<std::string> getMetaData(const std::string &key) const override {
+        return m_storage->getMetaData(key, m_options);
+    }
+
+    std::list<std::string>
+    listMetaData(const std::string &prefix, const std::string &startAfter, uint32_t count) const override {
+        return m_storage->listMetaData(prefix, startAfter, count, m_options);
+    }
+
+  private:
+    std::shared_ptr<const StorageLevelDb> m_storage;
+    const leveldb::Snapshot *m_snapshot;
+    leveldb::ReadOptions m_options;
+};
+
+std::shared_ptr<const Storage> StorageLevelDb::snapshot() const {
+    return std::make_shared<StorageLevelDbSnapshot>(std::static_pointer_cast<const StorageLevelDb>(shared_from_this()));
+}
+
 }  // namespace mnemosyne
\ No newline at end of file
@@ -8,6 +8,8 @@
 namespace mnemosyne {
 namespace storage {
 
+class StorageLevelDbSnapshot;
+
 class StorageLevelDb : public Storage {
   public:
     StorageLevelDb(const std::string &dbDir);
@@ -28,6 +30,29 @@ class StorageLevelDb : public Storage {
 
     std::optional<std::string> getMetaData(const std::string &key) const override;
 
+    void deleteMetaData(const std::string &key) override;
+
+    std::list<std::string>
+    listMetaData(const std::string &prefix, const std::string &startAfter = "", uint32_t count = 0) const override;
+
+    /**
+     * A view over a LevelDB snapshot, which is safe to read from other threads.
+     */
+    std::shared_ptr<const Storage> snapshot() const override;
+
+  private:
+    friend class StorageLevelDbSnapshot;
+
+    std::shared_ptr<const ndn::Data>
+    getRecord(const ndn::Name &recordName, const leveldb::ReadOptions &options) const;
+
+    std::list<ndn::Name> listRecord(const ndn::Name &prefix, uint32_t count, const leveldb::ReadOptions &options) const;
+
+    std::optional<std::string> getMetaData(const std::string &key, const leveldb::ReadOptions &options) const;
+
+    std::list<std::string> listMetaData(const std::string &prefix, const std::string &startAfter, uint32_t count,
+                                        const leveldb::ReadOptions &options) const;
+
   private:
     leveldb::DB *m_db;
     const char RECORD_PREFIX_CHAR = '/';
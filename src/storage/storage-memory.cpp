@@ -7,41 +7,120 @@ using namespace ndn;
 namespace mnemosyne::storage {
 
 shared_ptr<const Data> StorageMemory::getRecord(const Name &recordName) const {
-    auto it = m_recordStorage.find(recordName);
-    if (it == m_recordStorage.end()) return nullptr;
-    else return it->second;
+    return getRecord(*m_contents, recordName);
 }
 
 bool StorageMemory::putRecord(const shared_ptr<const Data> &recordData) {
-    m_recordStorage.emplace(recordData->getFullName(), recordData);
+    getWritableContents().recordStorage.emplace(recordData->getFullName(), recordData);
     return true;
 }
 
 void StorageMemory::deleteRecord(const Name &recordName) {
-    auto it = m_recordStorage.find(recordName);
-    if (it != m_recordStorage.end()) {
-        m_recordStorage.erase(it);
-    }
+    if (m_contents->recordStorage.count(recordName) == 0) return;
+    getWritableContents().recordStorage.erase(recordName);
 }
 
 std::list<Name> StorageMemory::listRecord(const Name &prefix, uint32_t count) const {
-    std::list<Name> names;
-    for (auto it = m_recordStorage.lower_bound(prefix);
-         it != m_recordStorage.end() && prefix.isPrefixOf(it->first) && (count == 0 || names.size() < count); it++) {
-        names.emplace_back(it->first);
-    }
-    return names;
+    return listRecord(*m_contents, prefix, count);
 }
 
 bool StorageMemory::placeMetaData(std::string k, const std::string &v) {
-    m_metaDataStore.emplace(k, v);
+    getWritableContents().metaDataStore.insert_or_assign(std::move(k), v);
     return true;
 }
 
 std::optional<std::string> StorageMemory::getMetaData(const std::string &k) const {
-    auto it = m_metaDataStore.find(k);
-    if (it == m_metaDataStore.end()) return std::nullopt;
+    return getMetaData(*m_contents, k);
+}
+
+void StorageMemory::deleteMetaData(const std::string &k) {
+    if (m_contents->metaDataStore.count(k) == 0) return;
+    getWritableContents().metaDataStore.erase(k);
+}
+
+std::list<std::string>
+StorageMemory::listMetaData(const std::string &prefix, const std::string &startAfter, uint32_t count) const {
+    return listMetaData(*m_contents, prefix, startAfter, count);
+}
+
+StorageMemory::Contents &StorageMemory::getWritableContents() {
+    // decided by a flag of the writing thread rather than the use count, whose drop when a reader thread releases
+    // a snapshot does not order that reader's last reads before the writes here
+    if (m_shared) {
+        m_contents = std::make_shared<Contents>(*m_contents);
+        m_shared = false;
+    }
+    return *m_contents;
+}
+
+shared_ptr<const Data> StorageMemory::getRecord(const Contents &contents, const Name &recordName) {
+    auto it = contents.recordStorage.find(recordName);
+    if (it == contents.recordStorage.end()) return nullptr;
+    else return it->second;
+}
+
+std::list<Name> StorageMemory::listRecord(const Contents &contents, const Name &prefix, uint32_t count) {
+    std::list<Name> names;
+    for (auto it = contents.recordStorage.lower_bound(prefix);
+         it != contents.recordStorage.end() && prefix.isPrefixOf(it->first) && (count == 0 || names.size() < count);
+         it++) {
+        names.emplace_back(it->first);
+    }
+    return names;
+}
+
+std::optional<std::string> StorageMemory::getMetaData(const Contents &contents, const std::string &k) {
+    auto it = contents.metaDataStore.find(k);
+    if (it == contents.metaDataStore.end()) return std::nullopt;
     else return it->second;
 }
 
+std::list<std::string>
+StorageMemory::listMetaData(const Contents &contents, const std::string &prefix, const std::string &startAfter,
+                            uint32_t count) {
+    std::list<std::string> keys;
+    const auto &store = contents.metaDataStore;
+    auto it = startAfter < prefix ? store.lower_bound(prefix) : store.upper_bound(startAfter);
+    for (; it != store.end() && it->first.compare(0, prefix.size(), prefix) == 0 &&
+           (count == 0 || keys.size() < count); it++) {
+        keys.push_back(it->first);
+    }
+    return keys;
+}
+
+/**
+ * Reads of contents that the storage no longer changes.
+ */
+class StorageMemorySnapshot : public StorageSnapshot {
+  public:
+    explicit StorageMemorySnapshot(std::shared_ptr<const StorageMemory::Contents> contents) :
+            m_contents(std::move(contents)) {
+    }
+
+    std::shared_ptr<const ndn::Data> getRecord(const Name &recordName) const override {
+        return StorageMemory::getRecord(*m_contents, recordName);
+    }
+
+    std::list<Name> listRecord(const Name &prefix, uint32_t count) const override {
+        return StorageMemory::listRecord(*m_contents, prefix, count);
+    }
+
+    std::optional<std::string> getMetaData(const std::string &key) const override {
+        return StorageMemory::getMetaData(*m_contents, key);
+    }
+
+    std::list<std::string>
+    listMetaData(const std::string &prefix, const std::string &startAfter, uint32_t count) const override {
+        return StorageMemory::listMetaData(*m_contents, prefix, startAfter, count);
+    }
+
+  private:
+    std::shared_ptr<const StorageMemory::Contents> m_contents;
+};
+
+std::shared_ptr<const Storage> StorageMemory::snapshot() const {
+    m_shared = true;
+    return std::make_shared<StorageMemorySnapshot>(m_contents);
+}
+
 }  // namespace mnemosyne
\ No newline at end of file
@@ -8,6 +8,8 @@
 namespace mnemosyne {
 namespace storage {
 
+class StorageMemorySnapshot;
+
 class StorageMemory : public Storage {
 
   public:
@@ -26,9 +28,44 @@ class StorageMemory : public Storage {
 
     std::optional<std::string> getMetaData(const std::string &key) const override;
 
+    void deleteMetaData(const std::string &key) override;
+
+    std::list<std::string>
+    listMetaData(const std::string &prefix, const std::string &startAfter = "", uint32_t count = 0) const override;
+
+    /**
+     * A view sharing the current contents, which are copied on the next write rather than changed under it.
+     * That write copies the whole map of records and metadata, O(n) in the stored items, though not the records
+     * themselves, which are shared; the writes after it until the next snapshot change the copy in place.
+     */
+    std::shared_ptr<const Storage> snapshot() const override;
+
+  private:
+    struct Contents {
+        std::map<ndn::Name, std::shared_ptr<const ndn::Data>> recordStorage;
+        std::map<std::string, std::string> metaDataStore;
+    };
+
+    friend class StorageMemorySnapshot;
+
+    /**
+     * @return the contents to write to, copied first if a snapshot still shares them
+     */
+    Contents &getWritableContents();
+
+    static std::shared_ptr<const ndn::Data> getRecord(const Contents &contents, const ndn::Name &recordName);
+
+    static std::list<ndn::Name> listRecord(const Contents &contents, const ndn::Name &prefix, uint32_t count);
+
+    static std::optional<std::string> getMetaData(const Contents &contents, const std::string &key);
+
+    static std::list<std::string> listMetaData(const Contents &contents, const std::string &prefix,
+                                               const std::string &startAfter, uint32_t count);
+
   private:
-    std::map<ndn::Name, std::shared_ptr<const ndn::Data>> m_recordStorage;
-    std::map<std::string, std::string> m_metaDataStore;
+    std::shared_ptr<Contents> m_contents = std::make_shared<Contents>();
+    // whether a snapshot was taken of m_contents; only read and written on the writing thread
+    mutable bool m_shared = false;
 };
 
 }  // namespace storage
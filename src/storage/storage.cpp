@@ -3,8 +3,31 @@
 #include "storage-leveldb.h"
 #include "storage-memory.h"
 
+#include <ndn-cxx/util/exception.hpp>
+
 namespace mnemosyne::storage {
 
+bool StorageSnapshot::putRecord(const std::shared_ptr<const ndn::Data> &recordData) {
+    NDN_THROW(std::logic_error("Writing to a storage snapshot"));
+}
+
+void StorageSnapshot::deleteRecord(const ndn::Name &recordName) {
+    NDN_THROW(std::logic_error("Writing to a storage snapshot"));
+}
+
+bool StorageSnapshot::placeMetaData(std::string key, const std::string &value) {
+    NDN_THROW(std::logic_error("Writing to a storage snapshot"));
+}
+
+void StorageSnapshot::deleteMetaData(const std::string &key) {
+    NDN_THROW(std::logic_error("Writing to a storage snapshot"));
+}
+
+std::shared_ptr<const Storage> StorageSnapshot::snapshot() const {
+    // already immutable
+    return shared_from_this();
+}
+
 std::unique_ptr<Storage> getStorage(std::string type, const std::string &config) {
     std::transform(type.begin(), type.end(), type.begin(), ::tolower);
     if (type == "leveldb") {
@@ -7,10 +7,14 @@
 #include <ndn-cxx/data.hpp>
 
 #include <boost/noncopyable.hpp>
+#include <memory>
 
 namespace mnemosyne::storage {
 
-class Storage {
+/**
+ * Record and metadata persistence. Must be owned by a shared_ptr, which snapshots share.
+ */
+class Storage : public std::enable_shared_from_this<Storage> {
   public:
     virtual ~Storage() = default;
 
@@ -32,6 +36,37 @@ class Storage {
     virtual bool placeMetaData(std::string key, const std::string &value) = 0;
 
     virtual std::optional<std::string> getMetaData(const std::string &key) const = 0;
+
+    virtual void deleteMetaData(const std::string &key) = 0;
+
+    /**
+     * @return the metadata keys starting with @p prefix and ordered after @p startAfter, in key order
+     * @param count = 0 if listing all.
+     */
+    virtual std::list<std::string>
+    listMetaData(const std::string &prefix, const std::string &startAfter = "", uint32_t count = 0) const = 0;
+
+    /**
+     * @return a read-only view of the storage as of now. Its reads may run on any thread, concurrently with each
+     * other and with the writes to this storage, which stay on the thread calling snapshot().
+     */
+    virtual std::shared_ptr<const Storage> snapshot() const = 0;
+};
+
+/**
+ * Base of the read-only views returned by Storage::snapshot().
+ */
+class StorageSnapshot : public Storage {
+  public:
+    bool putRecord(const std::shared_ptr<const ndn::Data> &recordData) final;
+
+    void deleteRecord(const ndn::Name &recordName) final;
+
+    bool placeMetaData(std::string key, const std::string &value) final;
+
+    void deleteMetaData(const std::string &key) final;
+
+    std::shared_ptr<const Storage> snapshot() const final;
 };
 
 std::unique_ptr<Storage> getStorage(std::string type, const std::string &config);
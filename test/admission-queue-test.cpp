@@ -0,0 +1,82 @@
+#include "interface/admission-queue.h"
+#include <iostream>
+#include <vector>
+
+using namespace mnemosyne;
+using namespace ndn;
+
+interface::AdmissionQueue::Event
+makeEvent(const std::string &producer, uint64_t seq) {
+    Name producerName(producer);
+    return {Data(Name(producerName).appendNumber(seq)), producerName};
+}
+
+bool testTurnOrder() {
+    interface::AdmissionQueue queue(16);
+    for (uint64_t i = 0; i < 4; i++) queue.push(makeEvent("/flood", i));
+    queue.push(makeEvent("/quiet", 0));
+    // the quiet producer goes second, not behind the flood
+    auto first = queue.pop();
+    auto second = queue.pop();
+    if (!first || first->producer != Name("/flood")) return false;
+    if (!second || second->producer != Name("/quiet")) return false;
+    for (uint64_t i = 1; i < 4; i++) {
+        auto event = queue.pop();
+        if (!event || event->data.getName() != Name("/flood").appendNumber(i)) return false;
+    }
+    return !queue.pop() && queue.size() == 0;
+}
+
+bool testEviction() {
+    interface::AdmissionQueue queue(4);
+    for (uint64_t i = 0; i < 4; i++) {
+        if (!queue.push(makeEvent("/flood", i))) return false;
+    }
+    if (!queue.isFull()) return false;
+    // the flooding producer cannot push out its own events
+    if (queue.push(makeEvent("/flood", 4))) return false;
+    // another producer takes the place of the newest flood event
+    if (!queue.push(makeEvent("/quiet", 0))) return false;
+    if (queue.size() != 4 || queue.getDroppedCount() != 2) return false;
+    size_t flood = 0;
+    while (auto event = queue.pop()) {
+        if (event->producer == Name("/flood")) {
+            if (event->data.getName() == Name("/flood").appendNumber(3)) return false;
+            flood++;
+        }
+    }
+    return flood == 3;
+}
+
+bool testEvictLastEvent() {
+    interface::AdmissionQueue queue(2);
+    if (!queue.push(makeEvent("/a", 0)) || !queue.push(makeEvent("/b", 0))) return false;
+    // one of the single-event producers gives up its only event, and with it its turn
+    if (!queue.push(makeEvent("/c", 0))) return false;
+    std::vector<Name> producers;
+    while (auto event = queue.pop()) producers.push_back(event->producer);
+    if (producers.size() != 2 || producers.back() != Name("/c") || queue.size() != 0) return false;
+
+    // the evicted producer starts over with a single turn
+    auto evicted = producers.front() == Name("/a") ? Name("/b") : Name("/a");
+    if (!queue.push({Data(Name(evicted).appendNumber(1)), evicted}) || !queue.push(makeEvent("/c", 1))) return false;
+    auto first = queue.pop();
+    auto second = queue.pop();
+    return first && first->producer == evicted && second && second->producer == Name("/c") && !queue.pop();
+}
+
+#define TEST(testName) { auto success = testName(); \
+    if (!success) { \
+    std::cout << #testName" failed" << std::endl; \
+    } else { \
+    std::cout << #testName" with no errors" << std::endl; \
+    } \
+}
+
+int
+main(int argc, char **argv) {
+    TEST(testTurnOrder);
+    TEST(testEviction);
+    TEST(testEvictLastEvent);
+    return 0;
+}
@@ -1,4 +1,6 @@
 #include "storage/storage-leveldb.h"
+#include "mnemosyne/backend.hpp"
+#include "mnemosyne/record.hpp"
 #include <ndn-cxx/name.hpp>
 #include <iostream>
 
@@ -92,6 +94,122 @@ bool testMetaDataStore(const std::string &type) {
     return true;
 }
 
+bool testSnapshot(const std::string &type) {
+    auto backend = std::shared_ptr<storage::Storage>(storage::getStorage(type, "/tmp/test-snapshot.leveldb"));
+    for (const auto &name: backend->listRecord("/")) {
+        backend->deleteRecord(name);
+    }
+    auto a = makeData("/mnemosyne/a", "a");
+    auto b = makeData("/mnemosyne/b", "b");
+    backend->putRecord(a);
+    backend->placeMetaData("snapshot", "before");
+    auto snapshot = backend->snapshot();
+
+    backend->putRecord(b);
+    backend->deleteRecord(a->getFullName());
+    backend->placeMetaData("snapshot", "after");
+    if (snapshot->listRecord("/mnemosyne") != std::list<Name>{a->getFullName()}) return false;
+    if (!snapshot->getRecord(a->getFullName()) || snapshot->getRecord(b->getFullName())) return false;
+    if (snapshot->getMetaData("snapshot") != "before" || backend->getMetaData("snapshot") != "after") return false;
+    return backend->listRecord("/mnemosyne") == std::list<Name>{b->getFullName()};
+}
+
+/**
+ * @return the record @p seqId of @p producer carrying @p event, pointing to @p pointers or else to its preceding record
+ */
+std::shared_ptr<ndn::Data>
+makeRecordData(const Name &producer, uint64_t seqId, const Data &event, const std::list<Name> &pointers = {}) {
+    Record record(event, producer);
+    if (pointers.empty()) record.addPointer(Record::getRecordName(producer, seqId - 1));
+    for (const auto &pointer: pointers) record.addPointer(pointer);
+    auto data = make_shared<Data>(Record::getRecordName(producer, seqId));
+    auto content = makeEmptyBlock(tlv::Content);
+    record.wireEncode(content);
+    data->setContent(content);
+    data->setSignatureInfo(SignatureInfo(tlv::SignatureSha256WithRsa));
+    data->setSignatureValue(ndn::encoding::makeEmptyBlock(tlv::SignatureValue).getBuffer());
+    data->wireEncode();
+    return data;
+}
+
+bool testEventIndex() {
+    Backend backend("memory", "");
+    auto event = makeData("/client/event/1", "event 1");
+    auto a1 = makeRecordData("/a", 1, *event);
+    auto b1 = makeRecordData("/b", 1, *event);
+    backend.putRecord(a1);
+    backend.putRecord(b1);
+    backend.putRecord(makeRecordData("/a", 2, *makeData("/client/event/2", "event 2")));
+
+    if (backend.findRecordByEvent(event->getFullName()) != std::list<Name>{a1->getFullName(), b1->getFullName()}) {
+        return false;
+    }
+    if (!backend.findRecordByEvent(makeData("/client/event/3", "event 3")->getFullName()).empty()) return false;
+    backend.putRecord(makeRecordData("/b", 2, *makeData("/client/eventual/1", "not under /client/event")));
+    auto events = backend.listEvents("/client/event");
+    if (events.size() != 2) return false;
+    if (backend.listEvents("/client/event", events.front()) != std::list<Name>{events.back()}) return false;
+    backend.deleteRecord(a1->getFullName());
+    return backend.findRecordByEvent(event->getFullName()) == std::list<Name>{b1->getFullName()};
+}
+
+bool testReverseReferences() {
+    Backend backend("memory", "");
+    auto event = makeData("/client/event/1", "event 1");
+    auto a1 = makeRecordData("/a", 1, *event, {Record::getGenesisRecordFullName(Record::getRecordName("/a", 0))});
+    auto a2 = makeRecordData("/a", 2, *event, {a1->getFullName()});
+    auto b1 = makeRecordData("/b", 1, *event, {a1->getFullName(), a2->getFullName()});
+    for (const auto &record: {a1, a2, b1}) backend.putRecord(record);
+    backend.addReferencingRecord(a1->getFullName(), a2->getFullName());
+    backend.addReferencingRecord(a1->getFullName(), b1->getFullName());
+    backend.addReferencingRecord(a2->getFullName(), b1->getFullName());
+    // indexed again on re-fetch
+    backend.addReferencingRecord(a1->getFullName(), b1->getFullName());
+    if (backend.getReferencingRecords(a1->getFullName()) != std::list<Name>{a2->getFullName(), b1->getFullName()}) {
+        return false;
+    }
+    // a record whose name extends another does not list its references
+    if (!backend.getReferencingRecords(a1->getFullName().getPrefix(-1)).empty()) return false;
+
+    // deleting a record removes the references to and from it
+    backend.deleteRecord(a2->getFullName());
+    if (backend.getReferencingRecords(a1->getFullName()) != std::list<Name>{b1->getFullName()}) return false;
+    if (!backend.getReferencingRecords(a2->getFullName()).empty()) return false;
+    backend.deleteRecord(b1->getFullName());
+    return backend.getReferencingRecords(a1->getFullName()).empty() && backend.listMetaData("ReverseRef").empty();
+}
+
+bool testTimeIndex() {
+    Backend backend("memory", "");
+    auto now = time::system_clock::now();
+    std::list<Name> stored;
+    for (int i = 1; i <= 3; i++) {
+        auto record = makeRecordData("/a", i, *makeData("/client/event/" + std::to_string(i), "event"));
+        backend.putRecord(record);
+        stored.push_back(record->getFullName());
+    }
+    auto all = backend.listRecordsByTime(now - time::minutes(1), now + time::minutes(1));
+    if (all.size() != 3) return false;
+    all.sort();
+    stored.sort();
+    if (all != stored) return false;
+
+    auto first = backend.listRecordsByTime(now - time::minutes(1), now + time::minutes(1), 2);
+    auto rest = backend.listRecordsByTime(now - time::minutes(1), now + time::minutes(1), 2, first.back());
+    if (first.size() != 2 || rest.size() != 1) return false;
+    if (!backend.listRecordsByTime(now - time::minutes(2), now - time::minutes(1)).empty()) return false;
+
+    // an index entry lost after the time was kept is written again when the record is stored again
+    auto indexKeys = backend.listMetaData("TimeIndex");
+    backend.deleteMetaData(indexKeys.front());
+    if (backend.listRecordsByTime(now - time::minutes(1), now + time::minutes(1)).size() != 2) return false;
+    for (const auto &name: stored) backend.putRecord(backend.getRecord(name));
+    if (backend.listMetaData("TimeIndex") != indexKeys) return false;
+
+    backend.deleteRecord(rest.front());
+    return backend.listRecordsByTime(now - time::minutes(1), now + time::minutes(1)).size() == 2;
+}
+
 int
 main(int argc, char **argv) {
     auto success = testNameGet();
@@ -100,6 +218,24 @@ main(int argc, char **argv) {
     } else {
         std::cout << "testNameGet with no errors" << std::endl;
     }
+    success = testEventIndex();
+    if (!success) {
+        std::cout << "testEventIndex failed" << std::endl;
+    } else {
+        std::cout << "testEventIndex with no errors" << std::endl;
+    }
+    success = testReverseReferences();
+    if (!success) {
+        std::cout << "testReverseReferences failed" << std::endl;
+    } else {
+        std::cout << "testReverseReferences with no errors" << std::endl;
+    }
+    success = testTimeIndex();
+    if (!success) {
+        std::cout << "testTimeIndex failed" << std::endl;
+    } else {
+        std::cout << "testTimeIndex with no errors" << std::endl;
+    }
     std::string types[] = {"leveldb", "memory"};
     for (auto t: types) {
         success = testBackEnd(t);
@@ -120,6 +256,12 @@ main(int argc, char **argv) {
         } else {
             std::cout << t << " testMetaDataStore with no errors" << std::endl;
         }
+        success = testSnapshot(t);
+        if (!success) {
+            std::cout << t << " testSnapshot failed" << std::endl;
+        } else {
+            std::cout << t << " testSnapshot with no errors" << std::endl;
+        }
     }
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,109 @@
+#include "dag-sync/checkpoint.h"
+#include "dag-sync/inclusion-proof.h"
+#include "test-records.h"
+#include <ndn-cxx/name.hpp>
+#include <iostream>
+
+using namespace mnemosyne;
+using namespace ndn;
+
+Data
+makeCheckpointData(const Name &producer) {
+    svs::VersionVector versions;
+    versions.set("/a", 3);
+    versions.set("/b", 5);
+    dag::Checkpoint checkpoint(versions, {Record::getRecordName("/a", 3), Record::getRecordName("/b", 5)});
+    Data data(dag::Checkpoint::makeCheckpointName(producer));
+    auto content = makeEmptyBlock(tlv::Content);
+    checkpoint.wireEncode(content);
+    data.setContent(content);
+    fakeSign(data);
+    return data;
+}
+
+bool testEncoding() {
+    auto data = makeCheckpointData("/a");
+    if (!dag::Checkpoint::isCheckpointName(data.getName())) return false;
+    if (dag::Checkpoint::isCheckpointName(Record::getRecordName("/a", 1))) return false;
+    dag::Checkpoint decoded(data);
+    return decoded.getVersions().get("/a") == 3 && decoded.getVersions().get("/b") == 5 &&
+           decoded.getTips() == std::vector<Name>{Record::getRecordName("/a", 3), Record::getRecordName("/b", 5)};
+}
+
+bool testProof() {
+    Backend backend("memory", "");
+    auto checkpointRecord = makeRecordData("/a", 4, makeCheckpointData("/a"), {Record::getRecordName("/0", 0)});
+    backend.putRecord(checkpointRecord);
+    Data event("/event/1");
+    fakeSign(event);
+    auto b1 = makeRecordData("/b", 6, event, {checkpointRecord->getFullName()});
+    auto c1 = makeRecordData("/c", 1, event, {b1->getFullName()});
+    for (const auto &data: {b1, c1}) {
+        backend.putRecord(data);
+    }
+    backend.addReferencingRecord(checkpointRecord->getFullName(), b1->getFullName());
+    backend.addReferencingRecord(b1->getFullName(), c1->getFullName());
+
+    auto proof = dag::buildInclusionProof(backend, checkpointRecord->getFullName(), 2);
+    if (!proof || !dag::Checkpoint::verifyProof(*proof, 2)) return false;
+    if (dag::Checkpoint::verifyProof(*proof, 3)) return false;
+    // a record not referencing the ones before it breaks the proof
+    std::swap((*proof)[1], (*proof)[2]);
+    if (dag::Checkpoint::verifyProof(*proof, 2)) return false;
+    // a proof must start from a checkpoint
+    proof = dag::buildInclusionProof(backend, b1->getFullName(), 1);
+    return proof && !dag::Checkpoint::verifyProof(*proof, 1);
+}
+
+bool testForgedCheckpoint() {
+    auto name = dag::Checkpoint::makeCheckpointName("/a");
+    if (!dag::Checkpoint::isCheckpointOf(name, "/a") || dag::Checkpoint::isCheckpointOf(name, "/b") ||
+        dag::Checkpoint::isCheckpointOf(Name("/a/b/CHECKPOINT").appendVersion(), "/a"))
+        return false;
+
+    Data event("/event/1");
+    fakeSign(event);
+    auto proofOf = [&](const std::shared_ptr<Data> &checkpointRecord) {
+        auto b1 = makeRecordData("/b", 6, event, {checkpointRecord->getFullName()});
+        auto c1 = makeRecordData("/c", 1, event, {b1->getFullName()});
+        return std::vector<std::shared_ptr<const Data>>{checkpointRecord, b1, c1};
+    };
+    // a checkpoint named under another producer, as a client event may be
+    auto forged = makeRecordData("/a", 4, makeCheckpointData("/b"), {Record::getRecordName("/0", 0)});
+    if (dag::Checkpoint::verifyProof(proofOf(forged), 2)) return false;
+    // a checkpoint claiming the record carrying it
+    auto early = makeRecordData("/a", 3, makeCheckpointData("/a"), {Record::getRecordName("/0", 0)});
+    if (dag::Checkpoint::verifyProof(proofOf(early), 2)) return false;
+    auto genuine = makeRecordData("/a", 4, makeCheckpointData("/a"), {Record::getRecordName("/0", 0)});
+    if (!dag::Checkpoint::verifyProof(proofOf(genuine), 2)) return false;
+
+    // a tip that is not a record cannot be adopted
+    dag::Checkpoint checkpoint(svs::VersionVector(), {Name("/a/1")});
+    Data data(dag::Checkpoint::makeCheckpointName("/a"));
+    auto content = makeEmptyBlock(tlv::Content);
+    checkpoint.wireEncode(content);
+    data.setContent(content);
+    fakeSign(data);
+    try {
+        dag::Checkpoint decoded(data);
+        return false;
+    } catch (const std::runtime_error &) {
+    }
+    return true;
+}
+
+#define TEST(testName) { auto success = testName(); \
+    if (!success) { \
+    std::cout << #testName" failed" << std::endl; \
+    } else { \
+    std::cout << #testName" with no errors" << std::endl; \
+    } \
+}
+
+int
+main(int argc, char **argv) {
+    TEST(testEncoding);
+    TEST(testProof);
+    TEST(testForgedCheckpoint);
+    return 0;
+}
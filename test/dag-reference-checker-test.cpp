@@ -0,0 +1,131 @@
+#include "dag-sync/dag-reference-checker.h"
+#include "test-records.h"
+#include <ndn-cxx/name.hpp>
+#include <iostream>
+
+using namespace mnemosyne;
+using namespace ndn;
+
+/**
+ * build a chain of records on /a, with the first one pointing to a stored record on /b
+ */
+std::vector<std::shared_ptr<Data>>
+makeChain(Backend &backend, size_t length) {
+    auto base = makeRecordData("/b", 1, {Record::getRecordName("/c", 1)});
+    backend.putRecord(base);
+    std::vector<std::shared_ptr<Data>> chain;
+    Name preceding = base->getFullName();
+    for (size_t i = 1; i <= length; i++) {
+        chain.push_back(makeRecordData("/a", i, {preceding}));
+        preceding = chain.back()->getFullName();
+    }
+    return chain;
+}
+
+bool testReversedChain(size_t memoryLimit) {
+    auto backend = std::make_shared<Backend>("memory", "");
+    auto chain = makeChain(*backend, 2000);
+    std::vector<svs::SeqNo> accepted;
+    DagReferenceChecker checker(backend, [&](std::unique_ptr<Record> record, const Name &, svs::SeqNo seqId) {
+        backend->putRecord(record->getEncodedData());
+        accepted.push_back(seqId);
+    }, memoryLimit, std::chrono::seconds(600), 0);
+
+    for (size_t i = chain.size(); i > 0; i--) {
+        checker.addRecord(std::make_unique<Record>(chain[i - 1]), "/a", i);
+    }
+    if (accepted.size() != chain.size()) return false;
+    for (size_t i = 0; i < accepted.size(); i++) {
+        if (accepted[i] != i + 1) return false;
+    }
+    return true;
+}
+
+bool testInMemoryReversedChain() {
+    return testReversedChain(std::numeric_limits<size_t>::max());
+}
+
+bool testSpilledReversedChain() {
+    return testReversedChain(0);
+}
+
+bool testExpiredWaitingRecord() {
+    auto backend = std::make_shared<Backend>("memory", "");
+    auto chain = makeChain(*backend, 3);
+    std::vector<svs::SeqNo> accepted;
+    DagReferenceChecker checker(backend, [&](std::unique_ptr<Record> record, const Name &, svs::SeqNo seqId) {
+        backend->putRecord(record->getEncodedData());
+        accepted.push_back(seqId);
+    }, 0, std::chrono::seconds(0), 0);
+
+    checker.addRecord(std::make_unique<Record>(chain[2]), "/a", 3);
+    if (!accepted.empty()) return false;
+    // record 3 times out before record 1 arrives
+    checker.addRecord(std::make_unique<Record>(chain[0]), "/a", 1);
+    if (accepted.size() != 1) return false;
+    checker.addRecord(std::make_unique<Record>(chain[1]), "/a", 2);
+    return accepted.size() == 2 && accepted.back() == 2;
+}
+
+bool testSpilledRecordCleanup() {
+    auto backend = std::make_shared<Backend>("memory", "");
+    auto chain = makeChain(*backend, 3);
+    auto onReady = [](std::unique_ptr<Record>, const Name &, svs::SeqNo) {};
+    {
+        DagReferenceChecker checker(backend, onReady, 0, std::chrono::seconds(600), 0);
+        checker.addRecord(std::make_unique<Record>(chain[2]), "/a", 3);
+        if (backend->listMetaData("WaitingRecord").size() != 1) return false;
+    }
+    // a restarted logger fetches the records again
+    DagReferenceChecker restarted(backend, onReady, 0, std::chrono::seconds(0), 0);
+    if (!backend->listMetaData("WaitingRecord").empty()) return false;
+    // and drops them once expired, even if no other record arrives
+    restarted.addRecord(std::make_unique<Record>(chain[1]), "/a", 2);
+    if (backend->listMetaData("WaitingRecord").size() != 1) return false;
+    restarted.evictExpired();
+    return backend->listMetaData("WaitingRecord").empty();
+}
+
+bool testRecentRecords() {
+    // none of the preceding records are stored, so only the recent records can satisfy the references
+    auto backend = std::make_shared<Backend>("memory", "");
+    std::vector<svs::SeqNo> accepted;
+    DagReferenceChecker checker(backend, [&](std::unique_ptr<Record>, const Name &, svs::SeqNo seqId) {
+        accepted.push_back(seqId);
+    }, std::numeric_limits<size_t>::max(), std::chrono::seconds(600), 2);
+
+    std::vector<Name> preceding;
+    for (uint64_t i = 1; i <= 3; i++) {
+        preceding.push_back(makeRecordData("/b", i, {Record::getRecordName("/c", 1)})->getFullName());
+        checker.addAcceptedRecord(preceding.back());
+    }
+    checker.addRecord(std::make_unique<Record>(makeRecordData("/a", 1, {preceding[2]})), "/a", 1);
+    checker.addRecord(std::make_unique<Record>(makeRecordData("/a", 2, {preceding[1]})), "/a", 2);
+    if (accepted != std::vector<svs::SeqNo>{1, 2}) return false;
+    // the oldest is forgotten beyond the bound
+    checker.addRecord(std::make_unique<Record>(makeRecordData("/a", 3, {preceding[0]})), "/a", 3);
+    if (accepted.size() != 2) return false;
+
+    dag::RecentRecordSet recent(1);
+    recent.insert(preceding[0]);
+    recent.insert(Record::getRecordName("/b", 1));
+    return recent.contains(preceding[0]) && !recent.contains(Record::getRecordName("/b", 1));
+}
+
+#define TEST(testName) { auto success = testName(); \
+    if (!success) { \
+    std::cout << #testName" failed" << std::endl; \
+    } else { \
+    std::cout << #testName" with no errors" << std::endl; \
+    } \
+}
+
+int
+main(int argc, char **argv) {
+    TEST(testInMemoryReversedChain);
+    TEST(testSpilledReversedChain);
+    TEST(testExpiredWaitingRecord);
+    TEST(testSpilledRecordCleanup);
+    TEST(testRecentRecords);
+    return 0;
+}
@@ -0,0 +1,42 @@
+#include "dag-sync/hinted-fetch-cache.h"
+#include <iostream>
+
+using namespace mnemosyne;
+using namespace ndn;
+
+bool testServed() {
+    dag::HintedFetchCache cache(2, std::chrono::seconds(1));
+    cache.insertServed("/a/RECORD/1", std::make_shared<Data>("/a/RECORD/1"));
+    cache.insertServed("/a/RECORD/2", std::make_shared<Data>("/a/RECORD/2"));
+    if (cache.findServed("/a/RECORD/1") == nullptr) return false;
+    // /a/RECORD/2 is the least recently used
+    cache.insertServed("/a/RECORD/3", std::make_shared<Data>("/a/RECORD/3"));
+    return cache.findServed("/a/RECORD/2") == nullptr && cache.findServed("/a/RECORD/1") != nullptr &&
+           cache.findServed("/a/RECORD/3") != nullptr;
+}
+
+bool testMissing() {
+    dag::HintedFetchCache cache(2, std::chrono::seconds(1));
+    auto now = dag::HintedFetchCache::Clock::now();
+    cache.insertMissing("/a/RECORD/1", now);
+    if (!cache.isMissing("/a/RECORD/1", now + std::chrono::milliseconds(500))) return false;
+    if (cache.isMissing("/a/RECORD/1", now + std::chrono::seconds(1))) return false;
+    cache.insertMissing("/a/RECORD/2", now);
+    cache.eraseMissing("/a/RECORD/2");
+    return !cache.isMissing("/a/RECORD/2", now);
+}
+
+#define TEST(testName) { auto success = testName(); \
+    if (!success) { \
+    std::cout << #testName" failed" << std::endl; \
+    } else { \
+    std::cout << #testName" with no errors" << std::endl; \
+    } \
+}
+
+int
+main(int argc, char **argv) {
+    TEST(testServed);
+    TEST(testMissing);
+    return 0;
+}
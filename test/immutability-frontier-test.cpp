@@ -0,0 +1,49 @@
+#include "dag-sync/immutability-frontier.h"
+#include "test-records.h"
+#include <ndn-cxx/name.hpp>
+#include <iostream>
+
+using namespace mnemosyne;
+using namespace ndn;
+
+bool testChain() {
+    dag::ImmutabilityFrontier frontier(2);
+    frontier.recordUpdate(Record(makeRecordData("/a", 1, {Record::getRecordName("/a", 0), Record::getRecordName("/0", 0)})));
+    frontier.recordUpdate(Record(makeRecordData("/b", 1, {Record::getRecordName("/b", 0), Record::getRecordName("/a", 1)})));
+    if (frontier.getImmutableSeqNo("/a") != 0) return false;
+    // /c replicates /a through /b
+    frontier.recordUpdate(Record(makeRecordData("/c", 1, {Record::getRecordName("/c", 0), Record::getRecordName("/b", 1)})));
+    if (frontier.getImmutableSeqNo("/a") != 1) return false;
+    if (frontier.getImmutableSeqNo("/b") != 0) return false;
+    frontier.recordUpdate(Record(makeRecordData("/d", 1, {Record::getRecordName("/d", 0), Record::getRecordName("/c", 1)})));
+    if (frontier.getImmutableSeqNo("/b") != 1 || frontier.getImmutableSeqNo("/c") != 0) return false;
+    if (!frontier.isImmutable(Record::getRecordName("/a", 1))) return false;
+    if (frontier.isImmutable(Record::getRecordName("/c", 1))) return false;
+    return frontier.getImmutableSeqNo("/z") == 0;
+}
+
+bool testAdvance() {
+    dag::ImmutabilityFrontier frontier(2);
+    frontier.recordUpdate(Record(makeRecordData("/a", 1, {Record::getRecordName("/a", 0)})));
+    frontier.recordUpdate(Record(makeRecordData("/a", 2, {Record::getRecordName("/a", 1)})));
+    frontier.recordUpdate(Record(makeRecordData("/b", 1, {Record::getRecordName("/a", 1)})));
+    frontier.recordUpdate(Record(makeRecordData("/c", 1, {Record::getRecordName("/a", 2)})));
+    if (frontier.getImmutableSeqNo("/a") != 1) return false;
+    frontier.recordUpdate(Record(makeRecordData("/b", 2, {Record::getRecordName("/b", 1), Record::getRecordName("/a", 2)})));
+    return frontier.getImmutableSeqNo("/a") == 2;
+}
+
+#define TEST(testName) { auto success = testName(); \
+    if (!success) { \
+    std::cout << #testName" failed" << std::endl; \
+    } else { \
+    std::cout << #testName" with no errors" << std::endl; \
+    } \
+}
+
+int
+main(int argc, char **argv) {
+    TEST(testChain);
+    TEST(testAdvance);
+    return 0;
+}
@@ -0,0 +1,73 @@
+#include "dag-sync/immutable-waiters.h"
+#include "dag-sync/replication-counter.h"
+#include "test-records.h"
+#include <ndn-cxx/name.hpp>
+#include <iostream>
+
+using namespace mnemosyne;
+using namespace ndn;
+
+bool testOrder() {
+    dag::ImmutableWaiters waiters(2);
+    std::vector<uint64_t> called;
+    for (uint64_t seqId: {3, 1, 2, 5}) {
+        waiters.await(seqId, 0, [&called, seqId](uint64_t immutableSeqNo) {
+            if (immutableSeqNo >= seqId) called.push_back(seqId);
+        });
+    }
+    waiters.notify(0);
+    if (!called.empty()) return false;
+    waiters.notify(2);
+    if (called != std::vector<uint64_t>{1, 2}) return false;
+    waiters.notify(4);
+    if (called != std::vector<uint64_t>{1, 2, 3}) return false;
+    // each callback is called once
+    waiters.notify(4);
+    return called.size() == 3 && waiters.size() == 1;
+}
+
+bool testAlreadyImmutable() {
+    dag::ImmutableWaiters waiters(2);
+    uint64_t result = 0;
+    if (!waiters.await(2, 3, [&result](uint64_t immutableSeqNo) { result = immutableSeqNo; })) return false;
+    return result == 3 && waiters.size() == 0;
+}
+
+bool testNotTracked() {
+    dag::ImmutableWaiters waiters(0);
+    bool called = false;
+    if (waiters.await(1, 0, [&called](uint64_t) { called = true; })) return false;
+    waiters.notify(1);
+    return !called && waiters.size() == 0;
+}
+
+bool testReplication() {
+    // record /a 2 becomes immutable once replicated at two other producers
+    dag::ReplicationCounter counter("/a", 2);
+    dag::ImmutableWaiters waiters(2);
+    uint64_t result = 0;
+    waiters.await(2, counter.getMaxReferenceSeqNo(), [&result](uint64_t immutableSeqNo) { result = immutableSeqNo; });
+    counter.recordUpdate(Record(makeRecordData("/b", 1, {Record::getRecordName("/a", 2)})));
+    waiters.notify(counter.getMaxReferenceSeqNo());
+    if (result != 0) return false;
+    counter.recordUpdate(Record(makeRecordData("/c", 1, {Record::getRecordName("/a", 3)})));
+    waiters.notify(counter.getMaxReferenceSeqNo());
+    return result == 2;
+}
+
+#define TEST(testName) { auto success = testName(); \
+    if (!success) { \
+    std::cout << #testName" failed" << std::endl; \
+    } else { \
+    std::cout << #testName" with no errors" << std::endl; \
+    } \
+}
+
+int
+main(int argc, char **argv) {
+    TEST(testOrder);
+    TEST(testAlreadyImmutable);
+    TEST(testNotTracked);
+    TEST(testReplication);
+    return 0;
+}
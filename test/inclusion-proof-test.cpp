@@ -0,0 +1,59 @@
+#include "dag-sync/inclusion-proof.h"
+#include "mnemosyne/record.hpp"
+#include "test-records.h"
+#include <ndn-cxx/name.hpp>
+#include <iostream>
+
+using namespace mnemosyne;
+using namespace ndn;
+
+/**
+ * store a record of @p producer pointing to @p precedingRecord, and index the reference
+ */
+Name
+addRecord(Backend &backend, const Name &producer, uint64_t seqId, const Name &precedingRecord) {
+    auto data = makeRecordData(producer, seqId, {precedingRecord});
+    backend.putRecord(data);
+    backend.addReferencingRecord(precedingRecord, data->getFullName());
+    return data->getFullName();
+}
+
+std::vector<Name>
+getProofNames(const Backend &backend, const Name &recordName, size_t producerNum) {
+    std::vector<Name> names;
+    auto proof = dag::buildInclusionProof(backend, recordName, producerNum);
+    if (proof) {
+        for (const auto &data: *proof) names.push_back(data->getFullName());
+    }
+    return names;
+}
+
+bool testProof() {
+    Backend backend("memory", "");
+    auto a1 = addRecord(backend, "/a", 1, Record::getRecordName("/0", 0));
+    auto a2 = addRecord(backend, "/a", 2, a1);
+    auto b1 = addRecord(backend, "/b", 1, a1);
+    auto c1 = addRecord(backend, "/c", 1, b1);
+    auto d1 = addRecord(backend, "/d", 1, a2);
+    backend.addReferencingRecord(a1, b1);
+
+    if (backend.getReferencingRecords(a1) != std::list<Name>{a2, b1}) return false;
+    if (getProofNames(backend, a1, 1) != std::vector<Name>{a1, b1}) return false;
+    if (getProofNames(backend, a1, 2) != std::vector<Name>{a1, b1, a2, d1}) return false;
+    if (getProofNames(backend, a1, 3) != std::vector<Name>{a1, b1, a2, d1, c1}) return false;
+    return !dag::buildInclusionProof(backend, a1, 4) && !dag::buildInclusionProof(backend, c1, 1);
+}
+
+#define TEST(testName) { auto success = testName(); \
+    if (!success) { \
+    std::cout << #testName" failed" << std::endl; \
+    } else { \
+    std::cout << #testName" with no errors" << std::endl; \
+    } \
+}
+
+int
+main(int argc, char **argv) {
+    TEST(testProof);
+    return 0;
+}
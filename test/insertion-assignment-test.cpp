@@ -0,0 +1,86 @@
+#include "interface/insertion-assignment.h"
+#include <iostream>
+#include <set>
+#include <vector>
+
+using namespace mnemosyne;
+using namespace ndn;
+
+std::vector<interface::InsertionAssignment>
+makeLoggers(size_t count) {
+    std::vector<interface::InsertionAssignment> loggers;
+    for (size_t i = 0; i < count; i++) {
+        loggers.emplace_back(Name("/logger").appendNumber(i), std::chrono::seconds(10));
+    }
+    for (auto &logger: loggers) {
+        for (size_t i = 0; i < count; i++) {
+            logger.onLoggerActive(Name("/logger").appendNumber(i));
+        }
+    }
+    return loggers;
+}
+
+bool testAgreement() {
+    auto loggers = makeLoggers(5);
+    for (int event = 0; event < 100; event++) {
+        Name key = Name("/client/event").appendNumber(event);
+        std::vector<bool> ranks(loggers.size(), false);
+        for (auto &logger: loggers) {
+            auto rank = logger.getRank(key);
+            if (rank >= loggers.size() || ranks[rank]) return false;
+            ranks[rank] = true;
+        }
+    }
+    return true;
+}
+
+bool testLeave() {
+    auto loggers = makeLoggers(3);
+    auto now = interface::InsertionAssignment::Clock::now();
+    // /logger/2 stops publishing; the others keep seeing each other
+    loggers[0].onLoggerActive(Name("/logger").appendNumber(1), now + std::chrono::seconds(20));
+    loggers[1].onLoggerActive(Name("/logger").appendNumber(0), now + std::chrono::seconds(20));
+    for (int event = 0; event < 50; event++) {
+        Name key = Name("/client/event").appendNumber(event);
+        auto later = now + std::chrono::seconds(25);
+        if (loggers[0].getRank(key, later) + loggers[1].getRank(key, later) != 1) return false;
+    }
+    return true;
+}
+
+bool testIdleLogger() {
+    auto loggers = makeLoggers(3);
+    auto now = interface::InsertionAssignment::Clock::now();
+    // no logger publishes past the timeout, but all stay in the version vector
+    std::set<Name> synced{Name("/logger").appendNumber(0), Name("/logger").appendNumber(1),
+                          Name("/logger").appendNumber(2)};
+    for (auto &logger: loggers) {
+        logger.onLoggersSynced(synced, now + std::chrono::seconds(20));
+    }
+    for (int event = 0; event < 50; event++) {
+        Name key = Name("/client/event").appendNumber(event);
+        auto later = now + std::chrono::seconds(25);
+        size_t primaries = 0;
+        for (auto &logger: loggers) {
+            if (logger.getRank(key, later) == 0) primaries++;
+        }
+        if (primaries != 1) return false;
+    }
+    return true;
+}
+
+#define TEST(testName) { auto success = testName(); \
+    if (!success) { \
+    std::cout << #testName" failed" << std::endl; \
+    } else { \
+    std::cout << #testName" with no errors" << std::endl; \
+    } \
+}
+
+int
+main(int argc, char **argv) {
+    TEST(testAgreement);
+    TEST(testLeave);
+    TEST(testIdleLogger);
+    return 0;
+}
@@ -0,0 +1,56 @@
+#include "dag-sync/merkle-range-tree.h"
+#include <iostream>
+
+using namespace mnemosyne;
+
+dag::MerkleRangeTree::Digest
+makeDigest(uint8_t value) {
+    dag::MerkleRangeTree::Digest digest{};
+    digest[0] = value;
+    return digest;
+}
+
+bool testOrderIndependent() {
+    dag::MerkleRangeTree forward, backward;
+    for (uint8_t i = 1; i <= 9; i++) forward.set(i, makeDigest(i));
+    for (uint8_t i = 9; i >= 1; i--) backward.set(i, makeDigest(i));
+    if (forward.getHeight() != 4 || backward.getHeight() != 4) return false;
+    return forward.get(4, 0) == backward.get(4, 0) && forward.get(4, 0) != dag::MerkleRangeTree::EMPTY;
+}
+
+bool testGrowth() {
+    dag::MerkleRangeTree small, large;
+    small.set(1, makeDigest(1));
+    large.set(1, makeDigest(1));
+    large.set(6, makeDigest(6));
+    if (small.get(3, 0) != dag::MerkleRangeTree::lift(small.get(1, 0), 1, 3)) return false;
+    // the trees differ only in the right half of the root
+    return large.get(3, 0) != small.get(3, 0) && large.get(2, 0) == small.get(2, 0) &&
+           large.get(2, 1) != small.get(2, 1) && small.get(2, 1) == dag::MerkleRangeTree::EMPTY;
+}
+
+bool testUpdate() {
+    dag::MerkleRangeTree a, b;
+    for (uint8_t i = 1; i <= 4; i++) {
+        a.set(i, makeDigest(i));
+        b.set(i, makeDigest(i));
+    }
+    b.set(3, makeDigest(30));
+    return a.get(1, 0) == b.get(1, 0) && a.get(1, 1) != b.get(1, 1) && a.get(3, 0) != b.get(3, 0);
+}
+
+#define TEST(testName) { auto success = testName(); \
+    if (!success) { \
+    std::cout << #testName" failed" << std::endl; \
+    } else { \
+    std::cout << #testName" with no errors" << std::endl; \
+    } \
+}
+
+int
+main(int argc, char **argv) {
+    TEST(testOrderIndependent);
+    TEST(testGrowth);
+    TEST(testUpdate);
+    return 0;
+}
@@ -0,0 +1,98 @@
+#include "dag-sync/pending-records.h"
+#include "dag-sync/tailing-record-set.h"
+#include "test-records.h"
+#include <ndn-cxx/name.hpp>
+#include <iostream>
+
+using namespace mnemosyne;
+using namespace ndn;
+
+using Clock = dag::PendingRecords::Clock;
+
+/**
+ * Create the pending records of /a as the logger does, each pointing to one tail of another producer.
+ */
+std::vector<dag::PendingRecords::Entry>
+createRecords(dag::PendingRecords &pending, dag::TailingRecordSet &tails, uint64_t &seqId, std::mt19937_64 &rng) {
+    // the logger checks the tails before the first record
+    if (tails.size() < 1) return {};
+    return pending.create([&](Record &record) {
+        tails.selectInto(record, 1, rng);
+        auto data = std::make_shared<Data>(Record::getRecordName("/a", ++seqId));
+        fakeSign(*data);
+        record.setEncodedData(data);
+    }, [&] { return tails.size() >= 1; });
+}
+
+bool testShortTips() {
+    std::mt19937_64 rng(1);
+    dag::TailingRecordSet tails(1);
+    dag::PendingRecords pending(std::chrono::seconds(60));
+    std::vector<std::pair<size_t, std::string>> completed;
+    for (size_t i = 0; i < 3; i++) {
+        pending.push(Record(*makeData(Name("/event").appendNumber(i)), "/a"), [&completed, i](ReturnCode result) {
+            if (result.success()) completed.emplace_back(i, result.what());
+        });
+    }
+    uint64_t seqId = 0;
+    auto complete = [&](std::vector<dag::PendingRecords::Entry> created) {
+        for (auto &entry: created) {
+            entry.callback(ReturnCode::noError(entry.record.getRecordFullName().toUri()));
+        }
+    };
+
+    // no tails, so the records keep waiting
+    complete(createRecords(pending, tails, seqId, rng));
+    if (pending.size() != 3 || !completed.empty()) return false;
+    // a tail for one record only
+    tails.update("/b", Record::getRecordName("/b", 1), 1);
+    complete(createRecords(pending, tails, seqId, rng));
+    if (pending.size() != 2 || completed.size() != 1) return false;
+    tails.update("/c", Record::getRecordName("/c", 1), 1);
+    tails.update("/d", Record::getRecordName("/d", 1), 1);
+    complete(createRecords(pending, tails, seqId, rng));
+    if (!pending.empty() || completed.size() != 3) return false;
+
+    // completed in submission order, with consecutive sequence numbers
+    for (size_t i = 0; i < completed.size(); i++) {
+        if (completed[i].first != i) return false;
+        if (!Record::getRecordName("/a", i + 1).isPrefixOf(Name(completed[i].second))) return false;
+    }
+    return true;
+}
+
+bool testExpire() {
+    dag::PendingRecords pending(std::chrono::seconds(10));
+    auto start = Clock::now();
+    std::vector<uint16_t> results;
+    auto callback = [&results](ReturnCode result) { results.push_back(result.code()); };
+    pending.push(Record(*makeData("/event/1"), "/a"), callback, start);
+    pending.push(Record(*makeData("/event/2"), "/a"), callback, start + std::chrono::seconds(5));
+    pending.expire(start + std::chrono::seconds(9));
+    if (!results.empty()) return false;
+    pending.expire(start + std::chrono::seconds(10));
+    if (results != std::vector<uint16_t>{EC_TimingError} || pending.size() != 1) return false;
+    pending.expire(start + std::chrono::seconds(20));
+    if (results.size() != 2 || !pending.empty()) return false;
+
+    // no timeout
+    dag::PendingRecords unbounded(std::chrono::seconds(0));
+    unbounded.push(Record(*makeData("/event/1"), "/a"), callback, start);
+    unbounded.expire(start + std::chrono::hours(24));
+    return unbounded.size() == 1 && results.size() == 2;
+}
+
+#define TEST(testName) { auto success = testName(); \
+    if (!success) { \
+    std::cout << #testName" failed" << std::endl; \
+    } else { \
+    std::cout << #testName" with no errors" << std::endl; \
+    } \
+}
+
+int
+main(int argc, char **argv) {
+    TEST(testShortTips);
+    TEST(testExpire);
+    return 0;
+}
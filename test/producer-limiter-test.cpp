@@ -0,0 +1,74 @@
+#include "interface/producer-limiter.h"
+#include "interface/admission-queue.h"
+#include <iostream>
+
+using namespace mnemosyne;
+using namespace ndn;
+
+bool testTokenBucket() {
+    Config::ProducerShare share;
+    share.rate = 10;
+    share.burst = 5;
+    interface::ProducerLimiter limiter(Config::ProducerShare(), {{Name("/noisy"), share}});
+    auto now = interface::ProducerLimiter::Clock::now();
+    Name noisy("/noisy/client");
+    for (int i = 0; i < 5; i++) {
+        if (!limiter.acquire(noisy, now)) return false;
+    }
+    if (limiter.acquire(noisy, now)) return false;
+    // producers outside the prefix have the unlimited default
+    for (int i = 0; i < 100; i++) {
+        if (!limiter.acquire(Name("/quiet/client"), now)) return false;
+    }
+    // 0.2s refills two tokens
+    now += std::chrono::milliseconds(200);
+    if (!limiter.acquire(noisy, now) || !limiter.acquire(noisy, now) || limiter.acquire(noisy, now)) return false;
+    if (limiter.getThrottledCount() != 2 || limiter.getThrottledCount(noisy) != 2) return false;
+    // forgotten once refilled
+    limiter.evictIdle(now + std::chrono::milliseconds(100));
+    if (limiter.size() != 1) return false;
+    limiter.evictIdle(now + std::chrono::seconds(1));
+    return limiter.size() == 0 && limiter.getThrottledCount() == 2;
+}
+
+bool testLongestPrefix() {
+    Config::ProducerShare broad, narrow;
+    broad.weight = 2;
+    narrow.weight = 3;
+    interface::ProducerLimiter limiter(Config::ProducerShare(), {{Name("/org"), broad},
+                                                                {Name("/org/team"), narrow}});
+    return limiter.getShare(Name("/org/team/client")).weight == 3 &&
+           limiter.getShare(Name("/org/other")).weight == 2 &&
+           limiter.getShare(Name("/elsewhere")).weight == 1;
+}
+
+bool testWeightedTurns() {
+    interface::AdmissionQueue queue(16);
+    for (uint64_t i = 0; i < 4; i++) {
+        queue.push({Data(Name("/heavy").appendNumber(i)), Name("/heavy")}, 2);
+        queue.push({Data(Name("/light").appendNumber(i)), Name("/light")}, 1);
+    }
+    // the heavy producer takes two events per turn
+    std::vector<Name> expected{"/heavy", "/heavy", "/light", "/heavy", "/heavy", "/light", "/light", "/light"};
+    for (const auto &producer: expected) {
+        auto event = queue.pop();
+        if (!event || event->producer != producer) return false;
+    }
+    return !queue.pop();
+}
+
+#define TEST(testName) { auto success = testName(); \
+    if (!success) { \
+    std::cout << #testName" failed" << std::endl; \
+    } else { \
+    std::cout << #testName" with no errors" << std::endl; \
+    } \
+}
+
+int
+main(int argc, char **argv) {
+    TEST(testTokenBucket);
+    TEST(testLongestPrefix);
+    TEST(testWeightedTurns);
+    return 0;
+}
@@ -0,0 +1,120 @@
+#include "interface/query-pager.h"
+#include "mnemosyne/backend.hpp"
+#include "test-records.h"
+#include <iostream>
+#include <set>
+
+using namespace mnemosyne;
+using namespace ndn;
+
+/**
+ * Follow the pages from @p query, checking that each fits a packet.
+ * @return the names of the records of all pages, nullopt if a page is missing or too large
+ */
+std::optional<std::list<Name>> readAllPages(const interface::QueryPager &pager, Name query) {
+    std::list<Name> records;
+    for (int i = 0; i < 1000; i++) {
+        auto content = pager.answer(query);
+        if (!content) return std::nullopt;
+        Data page(Name(query).appendVersion());
+        page.setContent(*content);
+        fakeSign(page);
+        if (page.wireEncode().size() > MAX_NDN_PACKET_SIZE) return std::nullopt;
+        std::optional<Name> nextPage;
+        for (const auto &record: interface::QueryPager::getPageRecords(*content, nextPage)) {
+            records.push_back(record.getName());
+        }
+        if (!nextPage) return records;
+        query = *nextPage;
+    }
+    return std::nullopt;
+}
+
+bool testRecordQuery() {
+    Name queryPrefix("/logger/QUERY");
+    auto backend = std::make_shared<Backend>("memory", "");
+    for (uint64_t i = 1; i <= 40; i++) {
+        backend->putRecord(makeRecordData("/a", i, *makeData(Name("/event/a").appendNumber(i), std::string(400, 'a')),
+                                          {}));
+    }
+    interface::QueryPager pager(backend, queryPrefix);
+    auto records = readAllPages(pager, interface::QueryPager::makeRecordQuery(queryPrefix, "/a", 5, 34));
+    if (!records || records->size() != 30) return false;
+    uint64_t seqId = 5;
+    for (const auto &record: *records) {
+        if (record != Record::getRecordName("/a", seqId++)) return false;
+    }
+    return !pager.answer(interface::QueryPager::makeRecordQuery(queryPrefix, "/a", 34, 5)) &&
+           !pager.answer(Name(queryPrefix).append("OTHER"));
+}
+
+bool testEventQuery() {
+    Name queryPrefix("/logger/QUERY");
+    auto backend = std::make_shared<Backend>("memory", "");
+    // an event recorded in many records, which together do not fit a packet
+    auto duplicated = makeData("/event/a/0", std::string(400, 'a'));
+    for (uint64_t i = 1; i <= 30; i++) {
+        backend->putRecord(makeRecordData("/a", i, *duplicated, {}));
+    }
+    for (uint64_t i = 1; i <= 20; i++) {
+        backend->putRecord(makeRecordData("/b", i, *makeData(Name("/event/a").appendNumber(i), std::string(400, 'b')),
+                                          {}));
+        backend->putRecord(makeRecordData("/c", i, *makeData(Name("/event/c").appendNumber(i)), {}));
+    }
+    interface::QueryPager pager(backend, queryPrefix);
+    auto records = readAllPages(pager, interface::QueryPager::makeEventQuery(queryPrefix, "/event/a"));
+    if (!records) return false;
+    std::set<Name> distinct(records->begin(), records->end());
+    if (distinct.size() != records->size()) return false;
+    // the records of the other events all follow the part of the duplicated event that fits a packet
+    size_t duplicatedCount = 0, otherCount = 0;
+    for (const auto &record: *records) {
+        if (Name("/a").isPrefixOf(record)) duplicatedCount++;
+        else if (Name("/b").isPrefixOf(record)) otherCount++;
+        else return false;
+    }
+    return duplicatedCount > 0 && duplicatedCount < 30 && otherCount == 20;
+}
+
+bool testTimeQuery() {
+    Name queryPrefix("/logger/QUERY");
+    auto backend = std::make_shared<Backend>("memory", "");
+    for (uint64_t i = 1; i <= 30; i++) {
+        backend->putRecord(makeRecordData("/a", i, *makeData(Name("/event/a").appendNumber(i), std::string(400, 'a')),
+                                          {}));
+        backend->putRecord(makeRecordData("/b", i, *makeData(Name("/event/b").appendNumber(i), std::string(400, 'b')),
+                                          {}));
+    }
+    interface::QueryPager pager(backend, queryPrefix);
+    auto from = time::system_clock::now() - time::hours(1);
+    auto to = time::system_clock::now() + time::hours(1);
+    auto records = readAllPages(pager, interface::QueryPager::makeTimeQuery(queryPrefix, from, to));
+    if (!records || records->size() != 60) return false;
+    if (std::set<Name>(records->begin(), records->end()).size() != 60) return false;
+
+    auto filtered = readAllPages(pager, interface::QueryPager::makeTimeQuery(queryPrefix, from, to, std::nullopt,
+                                                                             Name("/event/b")));
+    if (!filtered || filtered->size() != 30) return false;
+    for (const auto &record: *filtered) {
+        if (!Name("/b").isPrefixOf(record)) return false;
+    }
+
+    auto early = readAllPages(pager, interface::QueryPager::makeTimeQuery(queryPrefix, from - time::hours(1), from));
+    return early && early->empty();
+}
+
+#define TEST(testName) { auto success = testName(); \
+    if (!success) { \
+    std::cout << #testName" failed" << std::endl; \
+    } else { \
+    std::cout << #testName" with no errors" << std::endl; \
+    } \
+}
+
+int
+main(int argc, char **argv) {
+    TEST(testRecordQuery);
+    TEST(testEventQuery);
+    TEST(testTimeQuery);
+    return 0;
+}
@@ -65,6 +65,24 @@ bool testIndirectRef() {
     return true;
 }
 
+bool testKthLocation() {
+    dag::ReplicationCounter counter("/a", 3);
+    counter.recordUpdate(makeRecord("/b", "/a", 1));
+    counter.recordUpdate(makeRecord("/c", "/a", 2));
+    counter.recordUpdate(makeRecord("/d", "/a", 3));
+    if (counter.getKthLocation(1) != 3 || counter.getKthLocation(2) != 2 || counter.getKthLocation(3) != 1)
+        return false;
+    if (counter.getKthLocation(4) != 0) return false;
+    counter.recordUpdate(makeRecord("/b", "/a", 4));
+    if (counter.getCounts() != std::list<uint64_t>{2, 3, 4}) return false;
+    // below the lowest counted location
+    counter.recordUpdate(makeRecord("/e", "/a", 1));
+    if (counter.getCounts() != std::list<uint64_t>{2, 3, 4}) return false;
+    counter.recordUpdate(makeRecord("/e", "/a", 5));
+    if (counter.getCounts() != std::list<uint64_t>{3, 4, 5}) return false;
+    return counter.getMaxReferenceSeqNo() == 3;
+}
+
 #define TEST(testName) { auto success = testName(); \
     if (!success) { \
     std::cout << #testName" failed" << std::endl; \
@@ -77,5 +95,6 @@ int
 main(int argc, char **argv) {
     TEST(testProducerRef);
     TEST(testIndirectRef);
+    TEST(testKthLocation);
     return 0;
 }
\ No newline at end of file
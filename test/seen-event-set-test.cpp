@@ -0,0 +1,76 @@
+#include "interface/seen-event-set.h"
+#include <iostream>
+
+using namespace mnemosyne;
+using namespace ndn;
+
+Name
+makeEvent(int i) {
+    return Name("/client/event").appendNumber(i);
+}
+
+bool testExpiry() {
+    interface::SeenEventSet set(std::chrono::seconds(10), 1024 * 1024);
+    auto now = interface::SeenEventSet::Clock::now();
+    for (int i = 0; i < 1000; i++) set.addEvent(makeEvent(i), now + std::chrono::milliseconds(i));
+    for (int i = 0; i < 1000; i++) {
+        if (!set.hasEvent(makeEvent(i), now + std::chrono::milliseconds(999))) return false;
+    }
+    if (set.hasEvent(makeEvent(1000), now)) return false;
+    // the first half expires
+    set.evictExpired(now + std::chrono::seconds(10) + std::chrono::milliseconds(499));
+    if (set.size() != 500) return false;
+    for (int i = 0; i < 1000; i++) {
+        if (set.hasEvent(makeEvent(i), now + std::chrono::seconds(10)) != (i >= 500)) return false;
+    }
+    return true;
+}
+
+bool testMemoryLimit() {
+    // room for about 100 events
+    interface::SeenEventSet set(std::chrono::seconds(10), 100 * 48);
+    for (int i = 0; i < 10000; i++) set.addEvent(makeEvent(i));
+    if (set.size() > 100 || set.size() < 50) return false;
+    // the most recent events are kept, and every kept one is still found after many evictions
+    for (int i = 10000 - (int) set.size(); i < 10000; i++) {
+        if (!set.hasEvent(makeEvent(i))) return false;
+    }
+    return !set.hasEvent(makeEvent(0));
+}
+
+bool testEncode() {
+    interface::SeenEventSet set(std::chrono::seconds(10), 1024 * 1024);
+    for (int i = 0; i < 10; i++) set.addEvent(makeEvent(i));
+    interface::SeenEventSet restored(std::chrono::seconds(10), 1024 * 1024);
+    restored.decode(set.encode());
+    if (restored.size() != 10) return false;
+    for (int i = 0; i < 10; i++) {
+        if (!restored.hasEvent(makeEvent(i))) return false;
+    }
+    if (restored.hasEvent(makeEvent(0), interface::SeenEventSet::Clock::now() + std::chrono::seconds(11))) {
+        return false;
+    }
+
+    // only the events added after the given count
+    auto backedUp = set.getAddedCount();
+    for (int i = 10; i < 15; i++) set.addEvent(makeEvent(i));
+    interface::SeenEventSet increment(std::chrono::seconds(10), 1024 * 1024);
+    increment.decode(set.encode(backedUp));
+    return increment.size() == 5 && increment.hasEvent(makeEvent(14)) && !increment.hasEvent(makeEvent(9));
+}
+
+#define TEST(testName) { auto success = testName(); \
+    if (!success) { \
+    std::cout << #testName" failed" << std::endl; \
+    } else { \
+    std::cout << #testName" with no errors" << std::endl; \
+    } \
+}
+
+int
+main(int argc, char **argv) {
+    TEST(testExpiry);
+    TEST(testMemoryLimit);
+    TEST(testEncode);
+    return 0;
+}
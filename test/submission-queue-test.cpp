@@ -0,0 +1,63 @@
+#include "dag-sync/submission-queue.h"
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace mnemosyne;
+
+bool testFull() {
+    dag::SubmissionQueue<int> queue(3);
+    if (queue.capacity() != 4) return false;
+    for (int i = 0; i < 4; i++) {
+        if (!queue.push(i)) return false;
+    }
+    int item = 4;
+    if (queue.push(item) || item != 4) return false;
+    if (queue.pop() != 0) return false;
+    if (!queue.push(item)) return false;
+    for (int i = 1; i <= 4; i++) {
+        if (queue.pop() != i) return false;
+    }
+    return !queue.pop();
+}
+
+bool testConcurrentProducers() {
+    const int producerNum = 4;
+    const int itemNum = 100000;
+    dag::SubmissionQueue<std::pair<int, int>> queue(64);
+    std::vector<std::thread> producers;
+    for (int p = 0; p < producerNum; p++) {
+        producers.emplace_back([&queue, p] {
+            for (int i = 0; i < itemNum; i++) {
+                std::pair<int, int> item(p, i);
+                while (!queue.push(item)) std::this_thread::yield();
+            }
+        });
+    }
+    // every item arrives once, in the order of its producer
+    std::vector<int> next(producerNum, 0);
+    bool inOrder = true;
+    for (int received = 0; received < producerNum * itemNum;) {
+        auto item = queue.pop();
+        if (!item) continue;
+        inOrder = inOrder && item->second == next[item->first]++;
+        received++;
+    }
+    for (auto &producer: producers) producer.join();
+    return inOrder && !queue.pop();
+}
+
+#define TEST(testName) { auto success = testName(); \
+    if (!success) { \
+    std::cout << #testName" failed" << std::endl; \
+    } else { \
+    std::cout << #testName" with no errors" << std::endl; \
+    } \
+}
+
+int
+main(int argc, char **argv) {
+    TEST(testFull);
+    TEST(testConcurrentProducers);
+    return 0;
+}
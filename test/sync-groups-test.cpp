@@ -0,0 +1,60 @@
+#include "dag-sync/sync-groups.h"
+#include "dag-sync/dag-reference-checker.h"
+#include "test-records.h"
+#include <ndn-cxx/name.hpp>
+#include <iostream>
+
+using namespace mnemosyne;
+using namespace ndn;
+
+bool testStableGroups() {
+    // the groups are part of the sync prefixes, so they must not change across versions or hosts
+    if (dag::SyncGroups::getGroup("/a", 4) != 3 || dag::SyncGroups::getGroup("/b", 4) != 2 ||
+        dag::SyncGroups::getGroup("/c", 4) != 1 || dag::SyncGroups::getGroup("/logger/1", 4) != 1 ||
+        dag::SyncGroups::getGroup("/logger/2", 4) != 0 || dag::SyncGroups::getGroup("/logger/1", 3) != 2) {
+        return false;
+    }
+    if (dag::SyncGroups::getGroup("/a", 1) != 0 || dag::SyncGroups::getGroup("/a", 0) != 0) return false;
+    dag::SyncGroups groups("/sync", "/a", 4);
+    return groups.getOwnGroup() == 3 && groups.getGroup("/b") == 2 &&
+           groups.getGroupPrefix(2) == Name("/sync").appendNumber(2) &&
+           dag::SyncGroups("/sync", "/a", 1).getGroupPrefix(0) == Name("/sync");
+}
+
+bool testFetchedOnReference() {
+    // /a and /y are in group 3, /b in group 2
+    dag::SyncGroups groups("/sync", "/a", 4);
+    auto backend = std::make_shared<Backend>("memory", "");
+    std::vector<Name> fetched;
+    DagReferenceChecker checker(backend, [](auto &&...) {}, std::numeric_limits<size_t>::max(),
+                                std::chrono::seconds(600), 0);
+    checker.setMissingRecordCallback([&](const Name &recordName) {
+        if (groups.isFetchedOnReference(recordName, 0)) fetched.push_back(recordName);
+    });
+
+    auto other = makeRecordData("/b", 1, {Record::getGenesisRecordFullName(Record::getRecordName("/b", 0))});
+    auto same = makeRecordData("/y", 1, {Record::getGenesisRecordFullName(Record::getRecordName("/y", 0))});
+    auto genesis = Record::getGenesisRecordFullName(Record::getRecordName("/c", 0));
+    // a record of another group is fetched once referenced, one of the own group comes with its sync update
+    checker.addRecord(std::make_unique<Record>(makeRecordData("/c", 1, {genesis, other->getFullName()})), "/c", 1);
+    checker.addRecord(std::make_unique<Record>(makeRecordData("/c", 2, {genesis, same->getFullName()})), "/c", 2);
+    if (fetched != std::vector<Name>{other->getFullName()}) return false;
+    // nor is one already collected
+    return !groups.isFetchedOnReference(other->getFullName(), 1) &&
+           !dag::SyncGroups("/sync", "/a", 1).isFetchedOnReference(other->getFullName(), 0);
+}
+
+#define TEST(testName) { auto success = testName(); \
+    if (!success) { \
+    std::cout << #testName" failed" << std::endl; \
+    } else { \
+    std::cout << #testName" with no errors" << std::endl; \
+    } \
+}
+
+int
+main(int argc, char **argv) {
+    TEST(testStableGroups);
+    TEST(testFetchedOnReference);
+    return 0;
+}
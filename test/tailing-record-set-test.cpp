@@ -0,0 +1,121 @@
+#include "dag-sync/tailing-record-set.h"
+#include "dag-sync/replication-aware-tip-selection.h"
+#include <ndn-cxx/name.hpp>
+#include <iostream>
+
+using namespace mnemosyne;
+using namespace ndn;
+
+Name
+makeTail(const Name &producer) {
+    return Record::getRecordName(producer, 1);
+}
+
+std::set<Name>
+selectProducers(TipSelectionPolicy &tails, size_t num, std::mt19937_64 &rng) {
+    Record record;
+    tails.selectInto(record, num, rng);
+    std::set<Name> producers;
+    for (const auto &pointer: record.getPointersFromHeader()) {
+        producers.insert(Record::getProducerPrefix(pointer));
+    }
+    return producers;
+}
+
+bool testPreferHighestCount() {
+    std::mt19937_64 rng(1);
+    dag::TailingRecordSet tails(3);
+    tails.update("/a", makeTail("/a"), 1);
+    tails.update("/b", makeTail("/b"), 3);
+    tails.update("/c", makeTail("/c"), 2);
+    tails.update("/d", makeTail("/d"), 2);
+
+    auto selected = selectProducers(tails, 2, rng);
+    if (selected.size() != 2 || !selected.count("/b")) return false;
+    if (selected.count("/a")) return false;
+
+    // /b is now at count 2 with one of /c and /d, the other two at count 1
+    selected = selectProducers(tails, 3, rng);
+    if (selected.size() != 3 || !selected.count("/b")) return false;
+    // one tail with a single remaining reference was used up
+    return tails.size() == 3;
+}
+
+bool testExhaustedTailRemoved() {
+    std::mt19937_64 rng(2);
+    dag::TailingRecordSet tails(3);
+    tails.update("/a", makeTail("/a"), 1);
+    tails.update("/b", makeTail("/b"), 1);
+    auto selected = selectProducers(tails, 2, rng);
+    if (selected.size() != 2 || tails.size() != 0) return false;
+
+    tails.update("/a", makeTail("/a"), 2);
+    tails.update("/a", Record::getRecordName("/a", 2), 1);
+    if (tails.getRecord("/a") != Record::getRecordName("/a", 2)) return false;
+    selectProducers(tails, 1, rng);
+    return !tails.contains("/a");
+}
+
+bool testUniformWithinCount() {
+    std::mt19937_64 rng(3);
+    std::map<Name, int> hits;
+    for (int round = 0; round < 3000; round++) {
+        dag::TailingRecordSet tails(3);
+        tails.update("/a", makeTail("/a"), 3);
+        tails.update("/b", makeTail("/b"), 3);
+        tails.update("/c", makeTail("/c"), 3);
+        for (const auto &p: selectProducers(tails, 1, rng)) {
+            hits[p]++;
+        }
+    }
+    for (const auto &[producer, count]: hits) {
+        if (count < 800 || count > 1200) return false;
+    }
+    return hits.size() == 3;
+}
+
+bool testPreferLeastReplicated() {
+    std::mt19937_64 rng(4);
+    dag::ReplicationAwareTipSelection tails(2);
+    tails.update("/a", makeTail("/a"), 3);
+    tails.update("/b", makeTail("/b"), 3);
+    tails.update("/c", makeTail("/c"), 3);
+
+    // /d references /a and /b, /e references /a
+    Record fromD;
+    fromD.addPointer(makeTail("/a"));
+    fromD.addPointer(makeTail("/b"));
+    fromD.setEncodedData(make_shared<Data>(Record::getRecordName("/d", 1)));
+    tails.onRecordAccepted(fromD);
+    Record fromE;
+    fromE.addPointer(makeTail("/a"));
+    fromE.setEncodedData(make_shared<Data>(Record::getRecordName("/e", 1)));
+    tails.onRecordAccepted(fromE);
+
+    auto selected = selectProducers(tails, 1, rng);
+    if (selected != std::set<Name>{"/c"}) return false;
+    selected = selectProducers(tails, 2, rng);
+    if (selected != std::set<Name>{"/b", "/c"}) return false;
+
+    // a new tail starts over with no replication
+    tails.update("/a", Record::getRecordName("/a", 2), 3);
+    selected = selectProducers(tails, 2, rng);
+    return selected == std::set<Name>{"/a", "/c"};
+}
+
+#define TEST(testName) { auto success = testName(); \
+    if (!success) { \
+    std::cout << #testName" failed" << std::endl; \
+    } else { \
+    std::cout << #testName" with no errors" << std::endl; \
+    } \
+}
+
+int
+main(int argc, char **argv) {
+    TEST(testPreferHighestCount);
+    TEST(testExhaustedTailRemoved);
+    TEST(testUniformWithinCount);
+    TEST(testPreferLeastReplicated);
+    return 0;
+}
@@ -0,0 +1,56 @@
+#ifndef MNEMOSYNE_TEST_RECORDS_H
+#define MNEMOSYNE_TEST_RECORDS_H
+
+#include "mnemosyne/record.hpp"
+#include <ndn-cxx/data.hpp>
+#include <list>
+#include <memory>
+#include <string>
+
+/**
+ * Records for the tests, signed with an empty signature, as the tests do not validate them.
+ */
+
+inline void
+fakeSign(ndn::Data &data) {
+    data.setSignatureInfo(ndn::SignatureInfo(ndn::tlv::SignatureSha256WithRsa));
+    data.setSignatureValue(ndn::encoding::makeEmptyBlock(ndn::tlv::SignatureValue).getBuffer());
+    data.wireEncode();
+}
+
+inline std::shared_ptr<ndn::Data>
+makeData(const ndn::Name &name, const std::string &content = "") {
+    auto data = std::make_shared<ndn::Data>(name);
+    data->setContent(ndn::make_span(reinterpret_cast<const uint8_t *>(content.data()), content.size()));
+    fakeSign(*data);
+    return data;
+}
+
+/**
+ * @return the Data of the record @p seqId of @p producer carrying @p event and pointing to @p pointers
+ */
+inline std::shared_ptr<ndn::Data>
+makeRecordData(const ndn::Name &producer, uint64_t seqId, const ndn::Data &event,
+               const std::list<ndn::Name> &pointers) {
+    mnemosyne::Record record(event, producer);
+    for (const auto &pointer: pointers) {
+        record.addPointer(pointer);
+    }
+    auto data = std::make_shared<ndn::Data>(mnemosyne::Record::getRecordName(producer, seqId));
+    auto content = ndn::makeEmptyBlock(ndn::tlv::Content);
+    record.wireEncode(content);
+    data->setContent(content);
+    fakeSign(*data);
+    return data;
+}
+
+/**
+ * @return the Data of a record carrying the event /event/<producer>/<seqId>
+ */
+inline std::shared_ptr<ndn::Data>
+makeRecordData(const ndn::Name &producer, uint64_t seqId, const std::list<ndn::Name> &pointers) {
+    return makeRecordData(producer, seqId, *makeData(ndn::Name("/event").append(producer).appendNumber(seqId)),
+                          pointers);
+}
+
+#endif //MNEMOSYNE_TEST_RECORDS_H
@@ -0,0 +1,179 @@
+#include "dag-sync/tailing-record-set.h"
+#include "dag-sync/replication-aware-tip-selection.h"
+#include "dag-sync/replication-counter.h"
+#include "test-records.h"
+#include <ndn-cxx/name.hpp>
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <queue>
+#include <tuple>
+
+using namespace mnemosyne;
+using namespace ndn;
+
+/**
+ * Simulate loggers that create records at random and receive each other's records after a fixed per-link delay,
+ * and measure the time from creating a record until its producer counts it as replicated (immutable).
+ */
+
+const size_t LOGGER_NUM = 16;
+const size_t RECORD_NUM = 4000;
+const size_t PRECEDING_RECORD_NUM = 3;
+const uint32_t MAX_SELF_RE_REF_COUNT = 3;
+const uint32_t MAX_COUNTED_REPLICATION = 3;
+const double CREATE_INTERVAL_MS = 10;
+const double MIN_DELAY_MS = 5;
+const double MAX_DELAY_MS = 80;
+// records created at the end never get referenced, so only the first ones are measured
+const double MEASURED_RATIO = 0.9;
+
+struct SimLogger {
+    Name prefix;
+    std::unique_ptr<TipSelectionPolicy> tails;
+    std::unique_ptr<dag::ReplicationCounter> counter;
+    uint64_t seqId = 0;
+    uint64_t immutableSeqId = 0;
+    std::vector<double> createTimes;
+    std::vector<size_t> createIndices;
+};
+
+struct Delivery {
+    double time;
+    uint64_t order;
+    size_t to;
+    std::shared_ptr<const Record> record;
+
+    bool operator>(const Delivery &other) const {
+        return std::tie(time, order) > std::tie(other.time, other.order);
+    }
+};
+
+struct Result {
+    std::vector<double> latencies;
+    size_t measured = 0;
+    size_t skipped = 0;
+};
+
+std::shared_ptr<const Record>
+createRecord(SimLogger &logger, std::mt19937_64 &rng) {
+    Data event(Name(logger.prefix).append("event").appendNumber(logger.seqId + 1));
+    fakeSign(event);
+    Record record(event, logger.prefix);
+    record.addPointer(logger.tails->getRecord(logger.prefix));
+    logger.tails->erase(logger.prefix);
+    logger.tails->selectInto(record, PRECEDING_RECORD_NUM - 1, rng);
+
+    auto data = make_shared<Data>(Record::getRecordName(logger.prefix, ++logger.seqId));
+    auto content = makeEmptyBlock(tlv::Content);
+    record.wireEncode(content);
+    data->setContent(content);
+    fakeSign(*data);
+    return std::make_shared<Record>(data);
+}
+
+void
+acceptRecord(SimLogger &logger, const Record &record, double now, Result &result, size_t measuredRecords) {
+    auto producer = Record::getProducerPrefix(record.getRecordFullName());
+    logger.tails->update(producer, record.getRecordFullName(), MAX_SELF_RE_REF_COUNT);
+    logger.tails->onRecordAccepted(record);
+    if (producer == logger.prefix) return;
+
+    logger.counter->recordUpdate(record);
+    auto immutableSeqId = logger.counter->getMaxReferenceSeqNo();
+    for (; logger.immutableSeqId < immutableSeqId; logger.immutableSeqId++) {
+        if (logger.createIndices[logger.immutableSeqId] < measuredRecords) {
+            result.latencies.push_back(now - logger.createTimes[logger.immutableSeqId]);
+        }
+    }
+}
+
+Result
+simulate(const std::string &policy, uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::vector<SimLogger> loggers(LOGGER_NUM);
+    for (size_t i = 0; i < LOGGER_NUM; i++) {
+        loggers[i].prefix = Name("/logger").appendNumber(i);
+    }
+    for (auto &logger: loggers) {
+        if (policy == "random") {
+            logger.tails = std::make_unique<dag::TailingRecordSet>(MAX_SELF_RE_REF_COUNT);
+        } else {
+            logger.tails = std::make_unique<dag::ReplicationAwareTipSelection>(MAX_COUNTED_REPLICATION);
+        }
+        logger.counter = std::make_unique<dag::ReplicationCounter>(logger.prefix, MAX_COUNTED_REPLICATION);
+        for (const auto &other: loggers) {
+            Data genesis(Record::getRecordName(other.prefix, 0));
+            fakeSign(genesis);
+            logger.tails->update(other.prefix, genesis.getFullName(), MAX_SELF_RE_REF_COUNT);
+        }
+    }
+
+    std::uniform_real_distribution<double> delayDistribution(MIN_DELAY_MS, MAX_DELAY_MS);
+    std::vector<std::vector<double>> delays(LOGGER_NUM, std::vector<double>(LOGGER_NUM));
+    for (auto &row: delays) {
+        for (auto &delay: row) delay = delayDistribution(rng);
+    }
+    std::exponential_distribution<double> intervalDistribution(1 / CREATE_INTERVAL_MS);
+    std::uniform_int_distribution<size_t> loggerDistribution(0, LOGGER_NUM - 1);
+
+    Result result;
+    auto measuredRecords = (size_t) (RECORD_NUM * MEASURED_RATIO);
+    std::priority_queue<Delivery, std::vector<Delivery>, std::greater<>> deliveries;
+    uint64_t order = 0;
+    size_t created = 0;
+    double nextCreation = intervalDistribution(rng);
+    while (created < RECORD_NUM || !deliveries.empty()) {
+        if (created < RECORD_NUM && (deliveries.empty() || nextCreation <= deliveries.top().time)) {
+            double now = nextCreation;
+            nextCreation += intervalDistribution(rng);
+            auto from = loggerDistribution(rng);
+            auto &logger = loggers[from];
+            if (logger.tails->size() < PRECEDING_RECORD_NUM) {
+                result.skipped++;
+                continue;
+            }
+            auto record = createRecord(logger, rng);
+            logger.createTimes.push_back(now);
+            logger.createIndices.push_back(created++);
+            if (logger.createIndices.back() < measuredRecords) result.measured++;
+            acceptRecord(logger, *record, now, result, measuredRecords);
+            for (size_t to = 0; to < LOGGER_NUM; to++) {
+                if (to != from) deliveries.push({now + delays[from][to], order++, to, record});
+            }
+        } else {
+            auto delivery = deliveries.top();
+            deliveries.pop();
+            acceptRecord(loggers[delivery.to], *delivery.record, delivery.time, result, measuredRecords);
+        }
+    }
+    return result;
+}
+
+void
+printResult(const std::string &policy, Result result) {
+    auto &l = result.latencies;
+    std::sort(l.begin(), l.end());
+    auto percentile = [&](double p) {
+        return l.empty() ? 0.0 : l[std::min(l.size() - 1, (size_t) (p * l.size()))];
+    };
+    double mean = 0;
+    for (auto i: l) mean += i / l.size();
+    std::cout << std::fixed << std::setprecision(1)
+              << std::setw(12) << policy << ": immutable " << l.size() << "/" << result.measured
+              << ", mean " << mean << " ms, p50 " << percentile(0.5) << " ms, p90 " << percentile(0.9)
+              << " ms, p99 " << percentile(0.99) << " ms, max " << (l.empty() ? 0.0 : l.back())
+              << " ms, skipped creations " << result.skipped << std::endl;
+}
+
+int
+main(int argc, char **argv) {
+    uint64_t seed = argc > 1 ? std::stoull(argv[1]) : 1;
+    std::cout << LOGGER_NUM << " loggers, " << RECORD_NUM << " records, " << PRECEDING_RECORD_NUM
+              << " preceding records, replication threshold " << MAX_COUNTED_REPLICATION << ", seed " << seed
+              << std::endl;
+    for (const std::string policy: {"random", "replication"}) {
+        printResult(policy, simulate(policy, seed));
+    }
+    return 0;
+}
@@ -0,0 +1,93 @@
+#include "dag-sync/width-controller.h"
+#include "mnemosyne/record.hpp"
+#include "test-records.h"
+#include <ndn-cxx/encoding/block-helpers.hpp>
+#include <iostream>
+
+using namespace mnemosyne;
+using namespace ndn;
+
+LoggerConfig
+makeConfig() {
+    LoggerConfig config("/sync", "/hint", "/a");
+    config.adaptiveWidth = true;
+    config.precedingRecordNum = 3;
+    config.minPrecedingRecordNum = 2;
+    config.maxPrecedingRecordNum = 4;
+    config.lowArrivalRate = 1;
+    config.highArrivalRate = 10;
+    config.widthReplicationLagThreshold = 5;
+    config.widthAdjustPeriod = std::chrono::seconds(1);
+    return config;
+}
+
+bool testAdjust() {
+    dag::WidthController controller(makeConfig());
+    auto now = dag::WidthController::Clock::now();
+    if (controller.getPrecedingRecordNum() != 3) return false;
+
+    // busy and replicated: narrower, down to the lower bound
+    for (int round = 1; round <= 3; round++) {
+        for (int i = 0; i < 100; i++) controller.onRecordArrival();
+        controller.adjust(0, now + std::chrono::seconds(round));
+    }
+    if (controller.getPrecedingRecordNum() != 2 || controller.getSelfReRefCount() != 1) return false;
+
+    // within the period: unchanged
+    controller.adjust(100, now + std::chrono::milliseconds(3500));
+    if (controller.getPrecedingRecordNum() != 2) return false;
+
+    // busy but lagging: wider, up to the upper bound
+    for (int round = 4; round <= 7; round++) {
+        for (int i = 0; i < 100; i++) controller.onRecordArrival();
+        controller.adjust(100, now + std::chrono::seconds(round));
+    }
+    if (controller.getPrecedingRecordNum() != 4) return false;
+
+    // idle: stays wide
+    controller.adjust(0, now + std::chrono::seconds(8));
+    return controller.getPrecedingRecordNum() == 4;
+}
+
+bool testFixed() {
+    auto config = makeConfig();
+    config.adaptiveWidth = false;
+    dag::WidthController controller(config);
+    controller.adjust(100, dag::WidthController::Clock::now() + std::chrono::seconds(10));
+    return controller.getPrecedingRecordNum() == 3 && controller.getMinPrecedingRecordNum() == 3 &&
+           controller.getMaxPrecedingRecordNum() == 3 && controller.getSelfReRefCount() == config.maxSelfReRefCount;
+}
+
+bool testPointerCountBounds() {
+    Record decoded(makeRecordData("/a", 1, {Record::getRecordName("/a", 0), Record::getRecordName("/b", 0),
+                                            Record::getRecordName("/c", 0)}));
+    if (decoded.getPointersFromHeader().size() != 3) return false;
+    decoded.checkPointerCount(2, 4);
+    try {
+        decoded.checkPointerCount(2);
+        return false;
+    } catch (const std::exception &) {
+    }
+    try {
+        decoded.checkPointerCount(4, 5);
+        return false;
+    } catch (const std::exception &) {
+    }
+    return true;
+}
+
+#define TEST(testName) { auto success = testName(); \
+    if (!success) { \
+    std::cout << #testName" failed" << std::endl; \
+    } else { \
+    std::cout << #testName" with no errors" << std::endl; \
+    } \
+}
+
+int
+main(int argc, char **argv) {
+    TEST(testAdjust);
+    TEST(testFixed);
+    TEST(testPointerCountBounds);
+    return 0;
+}